@@ -0,0 +1,509 @@
+////////////////////////////////////////////////////////////
+//
+// Benchmarks for the hot paths of the visualizer and the core.
+//
+//   ./compilar.sh bench
+//   ./bench.out --out bench/baseline.json            (record a baseline)
+//   ./bench.out --baseline bench/baseline.json       (compare against it)
+//
+// Options:
+//   --out FILE          write the results as JSON (default: stdout)
+//   --baseline FILE     compare with a previous --out file
+//   --tolerance PCT     allowed slowdown against the baseline (default 10)
+//   --filter TEXT       only run benchmarks whose name contains TEXT
+//   --min-time SECONDS  measuring time per benchmark (default 0.25)
+//   --no-window         skip benchmarks that need a window / GL context
+//
+// Exit code: 0 if everything is within tolerance, 1 on a regression,
+// 2 on a usage or I/O error.
+//
+////////////////////////////////////////////////////////////
+
+#include <SFML/Graphics.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../include/sfmlbutton.hpp"
+#include "../include/Tower.hpp"
+#include "../include/Scene.hpp"
+#include "../include/SceneRenderer.hpp"
+#include "../include/EmbeddedFont.hpp"
+#include "../include/hanoi/MoveKernel.hpp"
+#include "../include/hanoi/StaticSolution.hpp"
+
+namespace
+{
+    struct Result
+    {
+        std::string name;
+        int n;
+        double nsPerOp;
+        double itemsPerSecond;
+    };
+
+    struct Options
+    {
+        std::string outPath;
+        std::string baselinePath;
+        std::string filter;
+        double tolerance = 10.0;
+        double minTime = 0.25;
+        bool window = true;
+    };
+
+    // Runs body in five samples and keeps the fastest one, in ns per call
+    double measure(const std::function<void()>& body, double minTime)
+    {
+        typedef std::chrono::steady_clock Clock;
+
+        body();
+
+        // Find a batch size that takes about a fifth of the time budget
+        std::uint64_t batch = 1;
+        for (;;)
+        {
+            Clock::time_point start = Clock::now();
+            for (std::uint64_t i = 0; i < batch; ++i)
+            {
+                body();
+            }
+            double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+            if (elapsed >= minTime / 5 || batch >= (std::uint64_t(1) << 30))
+            {
+                break;
+            }
+            batch *= 2;
+        }
+
+        double best = 0;
+        for (int sample = 0; sample < 5; ++sample)
+        {
+            Clock::time_point start = Clock::now();
+            for (std::uint64_t i = 0; i < batch; ++i)
+            {
+                body();
+            }
+            double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / batch;
+            if (sample == 0 || ns < best)
+            {
+                best = ns;
+            }
+        }
+        return best;
+    }
+
+    // Board, disks and towers laid out as in the app
+    struct Scenario
+    {
+        hanoi::Board board;
+        std::vector<Disk> disks;
+        DiskGeometry geometry;
+        Tower a, b, c;
+        std::vector<Tower*> towers;
+        std::vector<sf::Color> colors;
+        sf::RectangleShape base;
+        sf::Text labelA, labelB, labelC;
+        std::vector<sf::Text*> labels;
+        SceneLayout layout;
+
+        static const float windowWidth;
+        static const float windowHeight;
+
+        Scenario(int numDisks, sf::Font& font)
+            : a(board, disks, 0, 'A'), b(board, disks, 1, 'B'), c(board, disks, 2, 'C'),
+              labelA("A", font, 14), labelB("B", font, 14), labelC("C", font, 14)
+        {
+            towers = { &a, &b, &c };
+            labels = { &labelA, &labelB, &labelC };
+            colors = { sf::Color::Red, sf::Color::Green, sf::Color::Blue, sf::Color::Yellow, sf::Color::Magenta };
+            layout = computeLayout(numDisks, 3, windowWidth, windowHeight);
+            base.setSize(sf::Vector2f(windowWidth - 100, layout.towerWidth + 6));
+            calculateTowersPos(towers, windowWidth, windowHeight, layout.towerHeight, base, labels);
+            setDisks(board, disks, geometry, a, numDisks, layout, colors);
+        }
+    };
+
+    const float Scenario::windowWidth = 900;
+    const float Scenario::windowHeight = 600;
+
+    class Runner
+    {
+        public:
+
+            Runner(const Options& options) : options(options) {}
+
+            void run(const std::string& name, int n, double items, const std::function<void()>& body)
+            {
+                if (!options.filter.empty() && name.find(options.filter) == std::string::npos)
+                {
+                    return;
+                }
+                Result result;
+                result.name = name;
+                result.n = n;
+                result.nsPerOp = measure(body, options.minTime);
+                result.itemsPerSecond = items * 1e9 / result.nsPerOp;
+                std::fprintf(stderr, "%-28s n=%-4d %14.1f ns/op %14.0f items/s\n", name.c_str(), n, result.nsPerOp, result.itemsPerSecond);
+                results.push_back(result);
+            }
+
+            const std::vector<Result>& getResults() const { return results; }
+
+        private:
+
+            const Options& options;
+            std::vector<Result> results;
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Benchmarks
+    ////////////////////////////////////////////////////////////
+
+    void benchSolve(Runner& runner, sf::Font& font)
+    {
+        for (int n : { 10, 16, 20, 24 })
+        {
+            Scenario scenario(n, font);
+            hanoi::MoveList operations;
+            runner.run("solveHanoi", n, double(calcularNMovimientos(n)), [&]()
+            {
+                operations.clear();
+                solveHanoi(n, scenario.towers, scenario.a, scenario.c, operations);
+            });
+        }
+
+        // Lo que reemplaza a solveHanoi al iniciar con pocos discos
+        for (int n : { 10, 15 })
+        {
+            volatile std::uint64_t sink = 0;
+            runner.run("StaticSolution", n, double(calcularNMovimientos(n)), [&]()
+            {
+                const hanoi::StaticSolution solution(n, 0, 2);
+                for (std::uint64_t i = 0; i < solution.size(); ++i)
+                {
+                    sink = sink + solution.at(i).disk;
+                }
+            });
+        }
+    }
+
+    void benchMoveDisk(Runner& runner, sf::Font& font)
+    {
+        for (int n : { 10, 16, 20 })
+        {
+            Scenario scenario(n, font);
+            hanoi::MoveList unused;
+            bool forward = true;
+            // Plays the whole solution, alternating A->C and C->A so no reset is needed
+            runner.run("moveDisk", n, double(calcularNMovimientos(n)), [&]()
+            {
+                hanoi::MoveGenerator generator(n, forward ? 0 : 2, forward ? 2 : 0);
+                for (hanoi::Move move : generator)
+                {
+                    moveDisk(*scenario.towers[move.source], *scenario.towers[move.destination], unused, false);
+                }
+                forward = !forward;
+            });
+        }
+    }
+
+    void benchSetDisks(Runner& runner, sf::Font& font)
+    {
+        for (int n : { 3, 15, 32, 64 })
+        {
+            Scenario scenario(n, font);
+            runner.run("setDisks", n, n, [&]()
+            {
+                setDisks(scenario.board, scenario.disks, scenario.geometry, scenario.a, n, scenario.layout, scenario.colors);
+            });
+            // Lo que cuesta un cambio de tamano de la ventana
+            runner.run("applyLayout", n, n, [&]()
+            {
+                applyLayout(scenario.geometry, scenario.towers, scenario.layout);
+            });
+        }
+    }
+
+    void benchKernel(Runner& runner)
+    {
+        for (int n : { 16, 24 })
+        {
+            hanoi::MoveGenerator generator(n);
+            std::vector<hanoi::PackedMove> out(generator.size());
+            for (int path = hanoi::ScalarKernel; path <= hanoi::bestKernelPath(); ++path)
+            {
+                std::string name = std::string("computeMoves/") + hanoi::kernelPathName(hanoi::KernelPath(path));
+                runner.run(name, n, double(generator.size()), [&]()
+                {
+                    hanoi::computeMoves(generator, 0, generator.size(), out.data(), hanoi::KernelPath(path));
+                });
+            }
+        }
+    }
+
+    void benchRender(Runner& runner, sf::Font& font)
+    {
+        sf::RenderTexture texture;
+        if (!texture.create(Scenario::windowWidth, Scenario::windowHeight + 50))
+        {
+            std::fprintf(stderr, "renderFrame: no se pudo crear la textura\n");
+            return;
+        }
+        SceneRenderer renderer(font);
+        for (int n : { 3, 8, 15, 32 })
+        {
+            Scenario scenario(n, font);
+            runner.run("renderFrame", n, 1, [&]()
+            {
+                texture.clear();
+                drawTowers(texture, scenario.towers, scenario.base, scenario.labels, scenario.layout.towerWidth, scenario.layout.towerHeight, font);
+                texture.display();
+            });
+            runner.run("renderFrame/batched", n, 1, [&]()
+            {
+                // Un frame de animacion: solo el disco en movimiento cambia
+                scenario.disks[0].markDirty();
+                texture.clear();
+                renderer.update(scenario.towers, scenario.geometry, scenario.base, scenario.labels, scenario.layout.towerWidth, scenario.layout.towerHeight);
+                texture.draw(renderer);
+                texture.display();
+            });
+        }
+    }
+
+    void benchButtons(Runner& runner, sf::Font& font)
+    {
+        sf::RenderWindow window(sf::VideoMode(Scenario::windowWidth, Scenario::windowHeight + 50), "bench", sf::Style::None);
+        window.setVisible(false);
+
+        // One event of each kind the main loop usually sees
+        std::vector<sf::Event> events(4);
+        events[0].type = sf::Event::MouseMoved;
+        events[0].mouseMove.x = 120;
+        events[0].mouseMove.y = 610;
+        events[1].type = sf::Event::MouseButtonPressed;
+        events[1].mouseButton.button = sf::Mouse::Left;
+        events[1].mouseButton.x = 120;
+        events[1].mouseButton.y = 610;
+        events[2].type = sf::Event::MouseButtonReleased;
+        events[2].mouseButton = events[1].mouseButton;
+        events[3].type = sf::Event::KeyPressed;
+        events[3].key.code = sf::Keyboard::Right;
+
+        for (int count : { 4, 16, 64 })
+        {
+            std::vector<RectButton> buttons;
+            buttons.reserve(count);
+            for (int i = 0; i < count; ++i)
+            {
+                float x = 50.f + (i % 16) * 50.f;
+                float y = 20.f + (i / 16) * 40.f;
+                buttons.emplace_back(font, sf::Vector2f(40.f, 20.f), sf::Vector2f(x, y));
+            }
+            runner.run("getButtonStatus", count, double(count) * events.size(), [&]()
+            {
+                for (sf::Event& event : events)
+                {
+                    for (RectButton& button : buttons)
+                    {
+                        button.getButtonStatus(window, event);
+                    }
+                }
+            });
+
+            ButtonRouter router;
+            for (RectButton& button : buttons)
+            {
+                router.add(button);
+            }
+            runner.run("ButtonRouter::dispatch", count, double(count) * events.size(), [&]()
+            {
+                for (sf::Event& event : events)
+                {
+                    router.dispatch(window, event);
+                }
+            });
+
+            // Drawing a panel: one frame per iteration, hover moving between two buttons
+            bool hoverFirst = false;
+            runner.run("drawButtons", count, 1, [&]()
+            {
+                hoverFirst = !hoverFirst;
+                buttons[0].setButtonState(hoverFirst, false);
+                buttons[1 % count].setButtonState(!hoverFirst, false);
+                window.clear();
+                for (RectButton& button : buttons)
+                {
+                    button.draw(window);
+                }
+                window.display();
+            });
+
+            ButtonBatch batch;
+            for (RectButton& button : buttons)
+            {
+                batch.add(button);
+            }
+            runner.run("drawButtons/batched", count, 1, [&]()
+            {
+                hoverFirst = !hoverFirst;
+                buttons[0].setButtonState(hoverFirst, false);
+                buttons[1 % count].setButtonState(!hoverFirst, false);
+                window.clear();
+                batch.update();
+                window.draw(batch);
+                window.display();
+            });
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // JSON
+    ////////////////////////////////////////////////////////////
+
+    // One result per line, so the baseline can be read back line by line
+    bool writeJson(const std::string& path, const std::vector<Result>& results)
+    {
+        std::ostringstream json;
+        json << "{\n  \"results\": [\n";
+        for (std::size_t i = 0; i < results.size(); ++i)
+        {
+            char line[256];
+            std::snprintf(line, sizeof(line), "    {\"name\": \"%s\", \"n\": %d, \"ns_per_op\": %.3f, \"items_per_second\": %.1f}%s\n",
+                          results[i].name.c_str(), results[i].n, results[i].nsPerOp, results[i].itemsPerSecond,
+                          i + 1 < results.size() ? "," : "");
+            json << line;
+        }
+        json << "  ]\n}\n";
+
+        if (path.empty() || path == "-")
+        {
+            std::cout << json.str();
+            return true;
+        }
+        std::ofstream file(path.c_str());
+        file << json.str();
+        return bool(file);
+    }
+
+    bool readJson(const std::string& path, std::map<std::string, double>& baseline)
+    {
+        std::ifstream file(path.c_str());
+        if (!file)
+        {
+            return false;
+        }
+        std::string line;
+        while (std::getline(file, line))
+        {
+            char name[128];
+            int n;
+            double ns;
+            if (std::sscanf(line.c_str(), " {\"name\": \"%127[^\"]\", \"n\": %d, \"ns_per_op\": %lf", name, &n, &ns) == 3)
+            {
+                baseline[std::string(name) + "/" + std::to_string(n)] = ns;
+            }
+        }
+        return true;
+    }
+
+    bool parseOptions(int argc, char* argv[], Options& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string flag = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (flag == "--no-window")
+            {
+                options.window = false;
+            }
+            else if (flag == "--out" && hasValue)
+            {
+                options.outPath = argv[++i];
+            }
+            else if (flag == "--baseline" && hasValue)
+            {
+                options.baselinePath = argv[++i];
+            }
+            else if (flag == "--tolerance" && hasValue)
+            {
+                options.tolerance = std::atof(argv[++i]);
+            }
+            else if (flag == "--filter" && hasValue)
+            {
+                options.filter = argv[++i];
+            }
+            else if (flag == "--min-time" && hasValue)
+            {
+                options.minTime = std::atof(argv[++i]);
+            }
+            else
+            {
+                std::fprintf(stderr, "Opcion desconocida: %s\n", flag.c_str());
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        return 2;
+    }
+
+    sf::Font font;
+    if (!loadEmbeddedFont(font)) {
+        std::fprintf(stderr, "No se pudo cargar la fuente incluida\n");
+        return 2;
+    }
+
+    Runner runner(options);
+    benchSolve(runner, font);
+    benchMoveDisk(runner, font);
+    benchSetDisks(runner, font);
+    benchKernel(runner);
+    if (options.window) {
+        benchRender(runner, font);
+        benchButtons(runner, font);
+    }
+
+    if (!writeJson(options.outPath, runner.getResults())) {
+        std::fprintf(stderr, "No se pudo escribir %s\n", options.outPath.c_str());
+        return 2;
+    }
+
+    if (options.baselinePath.empty()) {
+        return 0;
+    }
+
+    std::map<std::string, double> baseline;
+    if (!readJson(options.baselinePath, baseline)) {
+        std::fprintf(stderr, "No se pudo leer %s\n", options.baselinePath.c_str());
+        return 2;
+    }
+
+    int regressions = 0;
+    for (const Result& result : runner.getResults()) {
+        std::map<std::string, double>::const_iterator it = baseline.find(result.name + "/" + std::to_string(result.n));
+        if (it == baseline.end()) {
+            continue;
+        }
+        double change = (result.nsPerOp / it->second - 1.0) * 100.0;
+        if (change > options.tolerance) {
+            std::fprintf(stderr, "REGRESION %s n=%d: %.1f ns -> %.1f ns (+%.1f%%)\n", result.name.c_str(), result.n, it->second, result.nsPerOp, change);
+            regressions++;
+        }
+    }
+    std::fprintf(stderr, "%d regresiones (tolerancia %.1f%%)\n", regressions, options.tolerance);
+    return regressions > 0 ? 1 : 0;
+}
@@ -1,2 +1,22 @@
 shopt -s globstar
-g++ -Wall -g **/*.cpp -o app.out -lsfml-graphics -lsfml-window -lsfml-system
+mkdir -p build/hanoi
+
+# La fuente va dentro del ejecutable: build/Arial_ttf.h
+(cd fonts && xxd -i Arial.ttf) > build/Arial_ttf.h || exit 1
+
+# Nucleo sin SFML: build/libhanoi.a
+for f in src/hanoi/*.cpp; do
+    g++ -Wall -O2 -std=c++17 -pthread -c "$f" -o "build/hanoi/$(basename "${f%.cpp}").o" || exit 1
+done
+ar rcs build/libhanoi.a build/hanoi/*.o
+
+# Vista SFML compartida por la app y el benchmark (todo src/ menos main.cpp)
+VIEW_SOURCES=$(ls src/*.cpp | grep -v 'src/main.cpp')
+LIBS="-Lbuild -lhanoi -lsfml-graphics -lsfml-window -lsfml-system"
+
+g++ -Wall -g -std=c++17 -pthread -Ibuild src/main.cpp $VIEW_SOURCES -o app.out $LIBS || exit 1
+
+# ./compilar.sh bench construye tambien bench.out, con optimizaciones
+if [ "$1" = "bench" ]; then
+    g++ -Wall -O2 -g -std=c++17 -pthread -Ibuild bench/*.cpp $VIEW_SOURCES -o bench.out $LIBS || exit 1
+fi
@@ -0,0 +1,60 @@
+#ifndef BATCHSOLVER_HPP_INCLUDED
+#define BATCHSOLVER_HPP_INCLUDED
+
+////////////////////////////////////////////////////////////
+// HEADERS
+////////////////////////////////////////////////////////////
+
+#include <string>
+#include "hanoi/MoveGenerator.hpp"
+
+////////////////////////////////////////////////////////////
+///
+/// @brief Settings for a windowless solve
+///
+////////////////////////////////////////////////////////////
+
+struct BatchOptions
+{
+    enum Format { Text, VerboseText, Binary };
+
+    unsigned int numDisks = 0;
+    unsigned int numPegs = 3;
+    hanoi::Peg from = 0;
+    hanoi::Peg to = 2;
+    Format format = Text;
+    std::string outPath;        ///< Empty writes to stdout
+    unsigned int threads = 0;   ///< 0 uses every core
+};
+
+////////////////////////////////////////////////////////////
+///
+/// @brief Solves without SFML and streams the moves to a file or stdout
+///
+/// Moves are generated in chunks by the parallel generator and written
+/// as they come, so memory stays flat for any disk count. Binary output
+/// is a move log, written to a file with one pwrite slice per thread.
+/// Timing and throughput go to stderr, so stdout carries only the
+/// moves. Text lines come from hanoi::MoveTextWriter, compact or verbose.
+/// Returns the process exit code.
+///
+////////////////////////////////////////////////////////////
+
+int runBatch(const BatchOptions& options);
+
+////////////////////////////////////////////////////////////
+///
+/// @brief Checks that a move stream solves the puzzle, without SFML
+///
+/// A move log brings its own disks and pegs in the header. Anything
+/// else is read as compact text ("-" is stdin) for the disks and pegs
+/// in options. Each move is checked as it is read. The result goes to
+/// stderr: the first bad move, whether the goal was reached, and whether
+/// the count matches the optimal solution. Returns 0 only for a valid
+/// optimal stream.
+///
+////////////////////////////////////////////////////////////
+
+int runVerify(const std::string& path, const BatchOptions& options);
+
+#endif // BATCHSOLVER_HPP_INCLUDED
@@ -34,6 +34,8 @@
 
 ////////////////////////////////////////////////////////////
 
+class ButtonRouter;
+
 const sf::Color defaultColor = sf::Color(255,255,255);
 const sf::Color defaultHover = sf::Color(191, 191, 191);
 const sf::Color defaultPress = sf::Color(153, 153, 153);
@@ -81,6 +83,21 @@ class Button
         void setLabelColor(sf::Color color);
         void setLabelColor(sf::Color color, sf::Color hover, sf::Color press);
         void setButtonEnabled(bool enabled);
+        bool isButtonEnabled() const;
+
+        /// Shape used for hit-testing and colouring
+        virtual sf::Shape& getButtonShape() = 0;
+
+        /// Applies the colours for a hover/held state; does nothing if the state did not change
+        void setButtonState(bool hover, bool held);
+
+        /// False when the button should not be drawn at all
+        virtual bool isButtonDrawn() const { return true; }
+
+        /// Bumped on every visible change, so batches know when to rebuild
+        unsigned int getVisualVersion() const { return visualVersion; }
+
+        const sf::Text& getButtonLabel() const { return buttonLabel; }
 
         bool isHover = false;
         bool isPressed = false;
@@ -101,6 +118,17 @@ class Button
         std::string label;
         ColorSet buttonColorSet;
         ColorSet labelColorSet = ColorSet(sf::Color::Black) ;
+        ButtonRouter* router = nullptr;
+
+        // Last state whose colours were applied
+        void refreshButtonState();
+        bool stateValid = false;
+        bool stateHover = false;
+        bool stateHeld = false;
+        bool stateActive = true;
+        unsigned int visualVersion = 0;
+
+        friend class ButtonRouter;
 
     //end of protected
 };
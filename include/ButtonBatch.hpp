@@ -0,0 +1,66 @@
+#ifndef BUTTONBATCH_HPP_INCLUDED
+#define BUTTONBATCH_HPP_INCLUDED
+
+////////////////////////////////////////////////////////////
+// HEADERS
+////////////////////////////////////////////////////////////
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "Button.hpp"
+
+////////////////////////////////////////////////////////////
+///
+/// @brief Draws a set of buttons in one shape batch plus one
+/// glyph batch per label size
+///
+/// Shapes are triangulated into one untextured vertex array. Labels
+/// are laid out like sf::Text, from the font's glyph atlas. The
+/// arrays are rebuilt only when a button reports a visual change
+/// (hover, held, enabled, colours or label), so an idle panel costs
+/// its draw calls and nothing else. All labels must use one font.
+///
+/// Buttons must outlive the batch.
+///
+////////////////////////////////////////////////////////////
+
+class ButtonBatch : public sf::Drawable
+{
+    public:
+
+        ButtonBatch();
+
+        void add(Button& button);
+
+        /// Rebuilds the vertex arrays if any button changed since the last call
+        void update();
+
+        unsigned int getDrawCalls() const;
+
+    //end of public
+
+    protected:
+
+        struct GlyphBatch
+        {
+            unsigned int charSize;
+            sf::VertexArray vertices;
+        };
+
+        void draw(sf::RenderTarget& target, sf::RenderStates states) const;
+
+        void appendShape(sf::Shape& shape);
+        void appendLabel(const sf::Text& text);
+
+        std::vector<Button*> buttons;
+        std::vector<unsigned int> versions;
+        bool structureChanged;
+
+        const sf::Font* font;
+        sf::VertexArray shapes;
+        std::vector<GlyphBatch> glyphs;
+
+    //end of protected
+};
+
+#endif // BUTTONBATCH_HPP_INCLUDED
@@ -0,0 +1,73 @@
+#ifndef BUTTONROUTER_HPP_INCLUDED
+#define BUTTONROUTER_HPP_INCLUDED
+
+////////////////////////////////////////////////////////////
+// HEADERS
+////////////////////////////////////////////////////////////
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "Button.hpp"
+
+////////////////////////////////////////////////////////////
+///
+/// @brief Routes window events to a set of buttons
+///
+/// Replaces calling getButtonStatus on every button for every event.
+/// Only mouse events are looked at. Their position is taken from the
+/// event and mapped to view coordinates once. The button under it is
+/// found through a uniform grid over the enabled, active buttons, and
+/// only buttons whose hover or held state changes are touched.
+/// Enabling or disabling a button rebuilds the grid on the next event.
+/// Call invalidate() after moving or resizing a button.
+///
+/// Buttons must outlive the router.
+///
+////////////////////////////////////////////////////////////
+
+class ButtonRouter
+{
+    public:
+
+        ButtonRouter(float cellSize = 64.f);
+        ~ButtonRouter();
+
+        void add(Button& button);
+
+        void invalidate() { indexDirty = true; }
+
+        /// Updates hover/held/isPressed; returns the button clicked by this event, if any
+        Button* dispatch(sf::RenderWindow& window, const sf::Event& event);
+
+    //end of public
+
+    private:
+
+        ButtonRouter(const ButtonRouter&);
+        ButtonRouter& operator=(const ButtonRouter&);
+
+        void rebuild();
+        Button* hitTest(sf::Vector2f point) const;
+        void setHover(Button* button);
+
+        std::vector<Button*> buttons;
+
+        // Grid in view coordinates: cell c holds cellEntries[cellStart[c] .. cellStart[c + 1])
+        float cellSize;
+        sf::Vector2f origin;
+        unsigned int cols;
+        unsigned int rows;
+        std::vector<unsigned int> cellStart;
+        std::vector<Button*> cellEntries;
+        bool indexDirty;
+
+        sf::Vector2f mousePos;
+        bool mouseInside;
+        Button* hovered;
+        Button* held;
+        Button* clicked;
+
+    //end of private
+};
+
+#endif // BUTTONROUTER_HPP_INCLUDED
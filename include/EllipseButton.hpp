@@ -52,6 +52,7 @@ class EllipseButton: public Button
         void draw(sf::RenderWindow& window);
         void setButtonLabel(float charSize, std::string label);
         void setButtonLabel(float charSize);
+        sf::Shape& getButtonShape() { return button; }
 
         sf::CircleShape button;
 
@@ -0,0 +1,25 @@
+#ifndef EMBEDDEDFONT_HPP_INCLUDED
+#define EMBEDDEDFONT_HPP_INCLUDED
+
+////////////////////////////////////////////////////////////
+// HEADERS
+////////////////////////////////////////////////////////////
+
+#include <SFML/Graphics.hpp>
+#include <string>
+
+////////////////////////////////////////////////////////////
+
+// Caracteres que usan los textos de la interfaz: numeros, letras y signos
+extern const char UiCharacters[];
+
+// La fuente de la interfaz va dentro del ejecutable: compilar.sh genera
+// build/Arial_ttf.h con xxd -i a partir de fonts/Arial.ttf, asi que no se
+// busca ningun archivo y el directorio de trabajo no importa
+bool loadEmbeddedFont(sf::Font &font);
+
+// Rasteriza de una vez los caracteres de 'text' en el atlas de la fuente
+// para ese tamano; despues dibujarlos no rasteriza nada
+void prerasterize(const sf::Font &font, const std::string &text, unsigned int charSize);
+
+#endif // EMBEDDEDFONT_HPP_INCLUDED
@@ -0,0 +1,87 @@
+#ifndef FRAMEEXPORTER_HPP_INCLUDED
+#define FRAMEEXPORTER_HPP_INCLUDED
+
+////////////////////////////////////////////////////////////
+// HEADERS
+////////////////////////////////////////////////////////////
+
+#include <SFML/Graphics.hpp>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+////////////////////////////////////////////////////////////
+///
+/// @brief Writes rendered frames from a pool of worker threads
+///
+/// The render loop hands over each frame and keeps going. Workers
+/// encode frames in any order. PngSequence writes one numbered file
+/// per frame into a directory. RawStream writes RGBA8 frames back to
+/// back into one file, each at its own offset, ready for
+/// `ffmpeg -f rawvideo -pix_fmt rgba -s WxH -r FPS -i FILE`.
+/// The queue is bounded, so a slow disk slows the renderer down
+/// instead of filling memory.
+///
+////////////////////////////////////////////////////////////
+
+class FrameExporter
+{
+    public:
+
+        enum Format { PngSequence, RawStream };
+
+        FrameExporter();
+        ~FrameExporter();
+
+        /// Starts the workers; threads = 0 uses every core
+        bool open(const std::string& path, Format format, unsigned int width, unsigned int height, unsigned int threads = 0);
+
+        /// Queues a copy of the texture; blocks while the queue is full
+        void push(const sf::Texture& texture);
+
+        /// Waits for every queued frame; returns false if any failed
+        bool close();
+
+        std::uint64_t getFrameCount() const { return frameCount; }
+
+    //end of public
+
+    private:
+
+        struct Frame
+        {
+            std::uint64_t index;
+            std::unique_ptr<sf::Image> image;
+        };
+
+        FrameExporter(const FrameExporter&);
+        FrameExporter& operator=(const FrameExporter&);
+
+        void work();
+        bool encode(const Frame& frame);
+
+        std::string path;
+        Format format;
+        unsigned int width;
+        unsigned int height;
+        int fd;
+
+        std::vector<std::thread> workers;
+        std::deque<Frame> queue;
+        std::size_t capacity;
+        std::mutex mutex;
+        std::condition_variable notEmpty;
+        std::condition_variable notFull;
+        bool closing;
+        bool failed;
+        std::uint64_t frameCount;
+
+    //end of private
+};
+
+#endif // FRAMEEXPORTER_HPP_INCLUDED
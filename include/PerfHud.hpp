@@ -0,0 +1,83 @@
+#ifndef PERFHUD_HPP_INCLUDED
+#define PERFHUD_HPP_INCLUDED
+
+////////////////////////////////////////////////////////////
+// HEADERS
+////////////////////////////////////////////////////////////
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+////////////////////////////////////////////////////////////
+///
+/// @brief Frame timing by phase, kept in a fixed ring buffer
+/// and shown as a toggleable overlay
+///
+/// The main loop calls beginFrame(), then mark() at the end of each
+/// phase and endFrame() last. Only the newest Capacity samples are
+/// kept, so recording never allocates. The overlay text is rebuilt a
+/// few times per second, not every frame.
+///
+////////////////////////////////////////////////////////////
+
+class PerfHud
+{
+    public:
+
+        enum Phase { EventsPhase, UpdatePhase, DrawPhase, DisplayPhase, PhaseCount };
+
+        static const std::size_t Capacity = 1024;
+
+        PerfHud(const sf::Font& font, unsigned int charSize = 14);
+
+        void beginFrame();
+
+        /// Ends a phase: the time since the previous mark is charged to it
+        void mark(Phase phase);
+
+        void endFrame(unsigned int drawCalls, unsigned int moves);
+
+        void toggle() { visible = !visible; }
+        bool isVisible() const { return visible; }
+
+        void draw(sf::RenderTarget& target);
+
+        /// Writes the buffered samples, oldest first
+        bool dumpCsv(const std::string& path) const;
+
+    //end of public
+
+    private:
+
+        struct Sample
+        {
+            float phase[PhaseCount];    // milliseconds
+            float frame;                // milliseconds
+            unsigned int drawCalls;
+            unsigned int moves;
+        };
+
+        const Sample& at(std::size_t age) const;
+        void rebuildText();
+
+        std::vector<Sample> samples;
+        std::size_t next;
+        std::size_t count;
+        std::uint64_t totalFrames;
+
+        Sample current;
+        sf::Clock clock;
+        sf::Time frameStart;
+        sf::Time lastMark;
+
+        bool visible;
+        sf::Clock textClock;
+        sf::RectangleShape background;
+        sf::Text text;
+
+    //end of private
+};
+
+#endif // PERFHUD_HPP_INCLUDED
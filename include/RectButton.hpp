@@ -53,6 +53,8 @@ class RectButton: public Button
         void draw(sf::RenderWindow& window);
         void setButtonLabel(float charSize, std::string label);
         void setButtonLabel(float charSize);
+        sf::Shape& getButtonShape() { return button; }
+        bool isButtonDrawn() const { return enabled; }
 
         sf::RectangleShape button;
 
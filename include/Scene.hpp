@@ -0,0 +1,39 @@
+#ifndef SCENE_HPP_INCLUDED
+#define SCENE_HPP_INCLUDED
+
+////////////////////////////////////////////////////////////
+// HEADERS
+////////////////////////////////////////////////////////////
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "Tower.hpp"
+
+////////////////////////////////////////////////////////////
+
+template<typename T>
+T clamp(T value, T min, T max) {
+    if (value < min) {
+        return min;
+    }
+    if (value > max) {
+        return max;
+    }
+    return value;
+}
+
+sf::Color inverseLegibleColor(sf::Color color);
+float linearInterpolation(float a, float b, float t);
+// Entre 1/6 y 4/5 del alto del area de dibujo (100 a 480 px en la ventana original)
+float getTowerHeight(int numDisks, float windowHeight = 600);
+// Alto de cada disco para que la pila completa quepa en la torre (30 px como maximo)
+float getDiskHeight(int numDisks, float towerHeight);
+void animateDiskMove(Disk &disk, const sf::Vector2f init, const sf::Vector2f goal, const float towerMax, const float delta);
+// Reparte las torres a lo ancho de la ventana; con tres quedan en 1/4, 2/4 y 3/4
+void calculateTowersPos(std::vector<Tower*> &towers, const float windowWidth, const float windowHeight, float towerHeight, sf::RectangleShape &base, std::vector<sf::Text*> &labels);
+
+// Dibuja la base, las etiquetas, los palos y los discos de todas las torres con
+// una llamada por figura; SceneRenderer hace lo mismo en dos llamadas
+void drawTowers(sf::RenderTarget &target, std::vector<Tower*> &towers, sf::RectangleShape &base, std::vector<sf::Text*> &labels, const float towerWidth, const float towerHeight, sf::Font &font);
+
+#endif // SCENE_HPP_INCLUDED
@@ -0,0 +1,54 @@
+#ifndef SCENELAYOUT_HPP_INCLUDED
+#define SCENELAYOUT_HPP_INCLUDED
+
+////////////////////////////////////////////////////////////
+// HEADERS
+////////////////////////////////////////////////////////////
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+
+////////////////////////////////////////////////////////////
+
+// Medidas de la escena, calculadas de una vez a partir del numero de discos,
+// del numero de torres y del tamano del area de dibujo
+struct SceneLayout {
+    float towerHeight;
+    float towerWidth;
+    float diskHeight;
+    float maxDiskWidth;     // ancho del disco mas grande
+    float diskWidthStep;    // cuanto se angosta cada disco respecto al de abajo
+};
+
+// Con el area original de 900x600 da las mismas medidas que antes para
+// hasta 15 discos; con mas, los discos se afinan para que la pila quepa
+SceneLayout computeLayout(int numDisks, int numPegs, float width, float height);
+
+// Geometria de todos los discos en arreglos paralelos, indexados por el
+// numero de disco del nucleo (0 = el mas pequeno). SceneRenderer arma un
+// quad por disco recorriendo los arreglos de corrido, y un cambio de tamano
+// de la ventana solo reescribe anchos y alto: los Disk no se vuelven a crear
+struct DiskGeometry {
+    std::vector<float> x;               // esquina superior izquierda
+    std::vector<float> y;
+    std::vector<float> width;
+    std::vector<sf::Color> color;
+    std::vector<std::uint8_t> dirty;    // posicion o tamano cambiados desde el ultimo cuadro
+    float height;
+
+    DiskGeometry() : height(0) {}
+
+    std::size_t size() const {
+        return x.size();
+    }
+
+    void resize(std::size_t count);
+
+    // Anchos y alto segun el layout; las posiciones las pone cada torre
+    void applyLayout(const SceneLayout &layout);
+
+    void markAllDirty();
+};
+
+#endif // SCENELAYOUT_HPP_INCLUDED
@@ -0,0 +1,90 @@
+#ifndef SCENERENDERER_HPP_INCLUDED
+#define SCENERENDERER_HPP_INCLUDED
+
+////////////////////////////////////////////////////////////
+// HEADERS
+////////////////////////////////////////////////////////////
+
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <vector>
+#include "Tower.hpp"
+
+////////////////////////////////////////////////////////////
+///
+/// @brief Retained renderer for the base, pegs, disks and their
+/// labels, drawn in two draw calls
+///
+/// Every rectangle lives in one untextured vertex array. Every character
+/// lives in a second array textured with the font's glyph atlas for one
+/// character size. Each disk owns a fixed slot in both arrays. A frame
+/// only rewrites the slots of disks marked dirty in DiskGeometry, and
+/// the pegs and base only when their layout changes. A normal frame
+/// therefore touches one disk and allocates nothing.
+///
+/// Disks are drawn like instances of one unit quad: the per-disk data
+/// (position, width, colour) comes straight from the DiskGeometry
+/// arrays, and the shared height from the layout. SFML has no instanced
+/// draw call, so the expansion to vertices happens here, in a tight loop
+/// over those arrays.
+///
+/// When the disks get thinner than a couple of pixel rows (tens of disks
+/// on a short window) drawing each one is wasted work and unreadable.
+/// The renderer then switches to bands: each peg is drawn as a few
+/// shaded trapezoids over runs of disks, plus its top disk on its own.
+/// The bands reuse the disk slots and are rebuilt whenever a disk moves,
+/// which is at most one quad per disk. Disk numbers are left out as soon
+/// as they no longer fit on a disk.
+///
+////////////////////////////////////////////////////////////
+
+class SceneRenderer : public sf::Drawable
+{
+    public:
+
+        SceneRenderer(sf::Font& font, unsigned int charSize = 14);
+
+        /// Brings the vertex arrays up to date with the scene
+        void update(std::vector<Tower*>& towers, DiskGeometry& geometry, const sf::RectangleShape& base, std::vector<sf::Text*>& labels, float towerWidth, float towerHeight);
+
+        unsigned int getDrawCalls() const { return 2; }
+
+        /// Disks or bands rewritten by the last update
+        unsigned int getUpdatedDisks() const { return updatedDisks; }
+
+    //end of public
+
+    protected:
+
+        static const unsigned int DiskDigits = 2;      // disks are numbered 0-63
+
+        void draw(sf::RenderTarget& target, sf::RenderStates states) const;
+
+        void setQuad(sf::VertexArray& array, std::size_t first, sf::Vector2f position, sf::Vector2f size, sf::Color color);
+        void setText(std::size_t first, std::size_t maxChars, const std::string& text, sf::Vector2f position, sf::Color color);
+        void updateStatic(std::vector<Tower*>& towers, const sf::RectangleShape& base, std::vector<sf::Text*>& labels, float towerWidth, float towerHeight);
+        void updateDisk(const DiskGeometry& geometry, std::size_t index);
+        void updateBands(std::vector<Tower*>& towers, const DiskGeometry& geometry);
+        void setBand(const DiskGeometry& geometry, std::size_t band, float x, unsigned int bottom, unsigned int top);
+        const sf::Glyph& getGlyph(char c);
+
+        sf::Font& font;
+        unsigned int charSize;
+        sf::VertexArray shapes;
+        sf::VertexArray glyphs;
+        std::vector<sf::Glyph> glyphCache;
+        std::vector<bool> glyphCached;
+
+        // Layout of the static part when it was last written
+        std::vector<float> staticKey;
+        std::vector<float> scratchKey;
+        std::size_t numDisks;
+        std::size_t staticQuads;    // base and one per peg
+        unsigned int updatedDisks;
+        float diskHeight;
+        bool banded;               // disks drawn as bands, see updateBands
+
+    //end of protected
+};
+
+#endif // SCENERENDERER_HPP_INCLUDED
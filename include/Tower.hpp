@@ -0,0 +1,169 @@
+#ifndef TOWER_HPP_INCLUDED
+#define TOWER_HPP_INCLUDED
+
+////////////////////////////////////////////////////////////
+// HEADERS
+////////////////////////////////////////////////////////////
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+#include "hanoi/Board.hpp"
+#include "hanoi/MoveSequence.hpp"
+#include "SceneLayout.hpp"
+
+////////////////////////////////////////////////////////////
+
+// Un disco es una vista sobre su entrada en DiskGeometry: copiarlo es barato
+// y cambiar el tamano de la escena no lo invalida
+class Disk {
+public:
+    Disk(DiskGeometry& geometry, unsigned int index) : geometry(&geometry), index(index) {}
+
+    // Cada cambio de posicion marca el disco para que SceneRenderer
+    // actualice solo su geometria
+    void setPosition(float x, float y) {
+        geometry->x[index] = x;
+        geometry->y[index] = y;
+        geometry->dirty[index] = 1;
+    }
+
+    bool isDirty() const {
+        return geometry->dirty[index] != 0;
+    }
+
+    void markDirty() {
+        geometry->dirty[index] = 1;
+    }
+
+    void clearDirty() {
+        geometry->dirty[index] = 0;
+    }
+
+    sf::Vector2f getPosition() const {
+        return sf::Vector2f(geometry->x[index], geometry->y[index]);
+    }
+
+    sf::Vector2f getSize() const {
+        return sf::Vector2f(geometry->width[index], geometry->height);
+    }
+
+    // Numero que se muestra: 0 es el mas grande
+    int getNum() const {
+        return geometry->size() - 1 - index;
+    }
+
+    sf::Color getColor() const {
+        return geometry->color[index];
+    }
+
+private:
+    DiskGeometry* geometry;
+    unsigned int index;
+};
+
+// Vista de una torre sobre el tablero: los discos viven en un solo vector
+// indexado por el numero de disco del nucleo (0 = el mas pequeno)
+class Tower {
+public:
+    Tower(hanoi::Board& board, std::vector<Disk>& disks, hanoi::Peg peg, char letter)
+        : x(0), y(0), peg(peg), letter(letter), board(board), disks(disks) {}
+
+    // Coloca un disco en el nivel indicado (0 = sobre la base)
+    void placeDisk(Disk& disk, int level) {
+        const sf::Vector2f size = disk.getSize();
+        disk.setPosition(x - size.x / 2, y - (level + 1) * size.y);
+    }
+
+    // Recoloca todos los discos de la torre, del mas grande al mas pequeno
+    void placeDisks() {
+        int level = 0;
+        for (unsigned int index : board.disksOn(peg)) {
+            placeDisk(disks[index], level++);
+        }
+    }
+
+    // Mueve el disco superior a otra torre y lo deja en su posicion final
+    Disk& moveTopDiskTo(Tower& destination) {
+        Disk& disk = disks[board.move(peg, destination.peg)];
+        destination.placeDisk(disk, destination.size() - 1);
+        return disk;
+    }
+
+    bool isEmpty() const {
+        return board.isEmpty(peg);
+    }
+
+    int size() const {
+        return board.count(peg);
+    }
+
+    char getLetter() const {
+        return letter;
+    }
+
+    hanoi::Peg getPeg() const {
+        return peg;
+    }
+
+    Disk& getTopDisk() {
+        return disks[board.top(peg)];
+    }
+
+    unsigned int getTopDiskIndex() const {
+        return board.top(peg);
+    }
+
+    sf::Vector2f getPosition() const {
+        return sf::Vector2f(x, y);
+    }
+
+    void setPosition(float x, float y) {
+        this->x = x;
+        this->y = y;
+    }
+
+    std::uint64_t getDiskMask() const {
+        return board.getPeg(peg);
+    }
+
+    // Indices de los discos de la torre, de abajo hacia arriba
+    hanoi::DiskRange getDiskIndices() const {
+        return board.disksOn(peg);
+    }
+
+    Disk& getDisk(int index) {
+        return disks[index];
+    }
+
+private:
+    float x, y;
+    hanoi::Peg peg;
+    char letter;
+    hanoi::Board& board;
+    std::vector<Disk>& disks;
+};
+
+// Las operaciones se guardan empaquetadas en 2 bytes (hanoi::PackedMove), con
+// los discos numerados desde el mas pequeno; la vista los numera desde el mas grande
+void moveDisk(Tower& source, Tower& destination, hanoi::MoveList& operations, bool log = true);
+
+// Solo genera las operaciones, repartidas entre varios hilos; las torres no se modifican
+void solveHanoi(int n, std::vector<Tower*>& towers, Tower& source, Tower& destination, hanoi::MoveList& operations);
+
+// Pone numDisks discos en la torre 'a' con las medidas del layout
+void setDisks(hanoi::Board &board, std::vector<Disk> &disks, DiskGeometry &geometry, Tower &a, int numDisks, const SceneLayout &layout, std::vector<sf::Color> &colors, int numPegs = 3);
+
+// Cambia las medidas de los discos sin rehacerlos y los recoloca en sus torres
+void applyLayout(DiskGeometry &geometry, std::vector<Tower*> &towers, const SceneLayout &layout);
+
+// Reconstruye las torres tras 'movesDone' movimientos de la solucion sin repetirlos
+void seekOperation(hanoi::Board &board, std::vector<Tower*> &towers, int numDisks, Tower &source, Tower &destination, std::uint64_t movesDone);
+
+// Pone los discos tal como estan en 'state' (cualquier configuracion legal)
+void placeState(hanoi::Board &board, std::vector<Tower*> &towers, const hanoi::Board &state);
+
+// Exacto hasta 64 discos: 2^64 - 1 todavia cabe en 64 bits
+std::uint64_t calcularNMovimientos(int numDiscos, int numTorres = 3);
+
+#endif // TOWER_HPP_INCLUDED
@@ -0,0 +1,100 @@
+#ifndef HANOI_ASYNCLOGGER_HPP_INCLUDED
+#define HANOI_ASYNCLOGGER_HPP_INCLUDED
+
+////////////////////////////////////////////////////////////
+// HEADERS
+////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include "MoveGenerator.hpp"
+
+////////////////////////////////////////////////////////////
+
+namespace hanoi
+{
+    ////////////////////////////////////////////////////////////
+    ///
+    /// @brief Fixed-size entry passed from the logging thread to the
+    /// writer thread
+    ///
+    ////////////////////////////////////////////////////////////
+
+    struct LogRecord
+    {
+        enum Kind { MoveEvent, RestartEvent };
+
+        std::uint64_t time;         ///< Nanoseconds since the logger started
+        std::uint64_t index;
+        std::uint64_t total;
+        std::uint8_t kind;
+        std::uint8_t numDisks;
+        Move move;
+    };
+
+    ////////////////////////////////////////////////////////////
+    ///
+    /// @brief Console log written by a background thread
+    ///
+    /// One thread (the render loop) pushes records into a lock-free
+    /// single-producer, single-consumer ring. The writer thread formats
+    /// them with MoveTextWriter and writes whole batches. A push never
+    /// blocks or allocates: when the ring is full the record is dropped
+    /// and counted, and the writer reports the drops in the log itself.
+    ///
+    ////////////////////////////////////////////////////////////
+
+    class AsyncLogger
+    {
+        public:
+
+            /// Records the ring holds; a power of two
+            static const std::size_t Capacity = 1 << 12;
+
+            AsyncLogger();
+            ~AsyncLogger();
+
+            /// Starts the writer thread on a stream it does not own
+            bool start(std::FILE* stream);
+
+            /// Writes whatever is still queued and joins the writer thread
+            void stop();
+
+            /// Queues a move line; false if it was dropped
+            bool logMove(const Move& move, std::uint64_t index, std::uint64_t total, unsigned int numDisks);
+
+            /// Queues the restart message; false if it was dropped
+            bool logRestart();
+
+            std::uint64_t getDropped() const { return dropped.load(std::memory_order_relaxed); }
+
+        //end of public
+
+        private:
+
+            AsyncLogger(const AsyncLogger&);
+            AsyncLogger& operator=(const AsyncLogger&);
+
+            bool push(LogRecord& record);
+            void run();
+
+            LogRecord ring[Capacity];
+
+            // Each index on its own cache line, so the two threads do not share one
+            alignas(64) std::atomic<std::uint64_t> head;
+            alignas(64) std::atomic<std::uint64_t> tail;
+            alignas(64) std::atomic<std::uint64_t> dropped;
+            std::atomic<bool> running;
+
+            std::FILE* stream;
+            std::thread writer;
+            std::chrono::steady_clock::time_point startTime;
+
+        //end of private
+    };
+}
+
+#endif // HANOI_ASYNCLOGGER_HPP_INCLUDED
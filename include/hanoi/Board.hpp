@@ -0,0 +1,152 @@
+#ifndef HANOI_BOARD_HPP_INCLUDED
+#define HANOI_BOARD_HPP_INCLUDED
+
+////////////////////////////////////////////////////////////
+// HEADERS
+////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include "MoveGenerator.hpp"
+
+////////////////////////////////////////////////////////////
+
+namespace hanoi
+{
+    const unsigned int MaxDisks = 64;
+    const unsigned int MaxPegs = 16;
+
+    ////////////////////////////////////////////////////////////
+    ///
+    /// @brief Iterable view of the disks on one peg, from the bottom
+    /// (largest) to the top, without copying or allocating
+    ///
+    ////////////////////////////////////////////////////////////
+
+    class DiskRange
+    {
+        public:
+
+            class iterator
+            {
+                public:
+
+                    explicit iterator(std::uint64_t mask) : mask(mask) {}
+
+                    unsigned int operator*() const { return 63 - __builtin_clzll(mask); }
+                    iterator& operator++() { mask &= ~(std::uint64_t(1) << (63 - __builtin_clzll(mask))); return *this; }
+                    bool operator!=(const iterator& other) const { return mask != other.mask; }
+
+                //end of public
+
+                private:
+
+                    std::uint64_t mask;
+
+                //end of private
+            };
+
+            explicit DiskRange(std::uint64_t mask) : mask(mask) {}
+
+            iterator begin() const { return iterator(mask); }
+            iterator end() const { return iterator(0); }
+
+        //end of public
+
+        private:
+
+            std::uint64_t mask;
+
+        //end of private
+    };
+
+    ////////////////////////////////////////////////////////////
+    ///
+    /// @brief Puzzle state with one 64-bit disk mask per peg
+    ///
+    /// Bit i of a peg is set when disk i (0 = smallest) is on it, so
+    /// the top disk of a peg is its lowest set bit. Checking and
+    /// applying a move are a handful of bit operations, and the board
+    /// does not depend on SFML.
+    ///
+    ////////////////////////////////////////////////////////////
+
+    class Board
+    {
+        public:
+
+            Board();
+            Board(unsigned int numDisks, unsigned int numPegs = 3, Peg start = 0);
+
+            /// Stacks every disk on the start peg
+            void reset(unsigned int numDisks, unsigned int numPegs = 3, Peg start = 0);
+
+            unsigned int getNumDisks() const { return numDisks; }
+            unsigned int getNumPegs() const { return numPegs; }
+
+            /// Mask with one bit per disk on the board
+            std::uint64_t getAllDisks() const
+            {
+                return numDisks >= 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << numDisks) - 1;
+            }
+
+            std::uint64_t getPeg(Peg peg) const { return pegs[peg]; }
+            void setPeg(Peg peg, std::uint64_t mask) { pegs[peg] = mask; }
+
+            /// Disks on a peg, bottom first
+            DiskRange disksOn(Peg peg) const { return DiskRange(pegs[peg]); }
+
+            bool isEmpty(Peg peg) const { return pegs[peg] == 0; }
+            unsigned int count(Peg peg) const { return __builtin_popcountll(pegs[peg]); }
+
+            /// Top disk of a peg; the peg must not be empty
+            unsigned int top(Peg peg) const { return __builtin_ctzll(pegs[peg]); }
+
+            /// True if the source has a disk smaller than every disk on the destination
+            bool canMove(Peg source, Peg destination) const
+            {
+                const std::uint64_t from = pegs[source];
+                return from != 0 && (pegs[destination] & ((from & -from) - 1)) == 0;
+            }
+
+            /// Moves the top disk without checking legality and returns it
+            unsigned int move(Peg source, Peg destination)
+            {
+                const std::uint64_t bit = pegs[source] & -pegs[source];
+                pegs[source] ^= bit;
+                pegs[destination] |= bit;
+                return __builtin_ctzll(bit);
+            }
+
+            void apply(const Move& move)
+            {
+                this->move(move.source, move.destination);
+            }
+
+            /// Applies the move only if it is legal
+            bool tryMove(Peg source, Peg destination);
+
+            /// Peg holding a disk, or numPegs if the disk is not on the board
+            Peg pegOf(unsigned int disk) const;
+
+            /// True if every disk is on the goal peg
+            bool isComplete(Peg goal) const { return pegs[goal] == getAllDisks(); }
+
+            /// True if every disk is on exactly one peg
+            bool isValid() const;
+
+            bool operator==(const Board& other) const;
+            bool operator!=(const Board& other) const { return !(*this == other); }
+
+        //end of public
+
+        private:
+
+            unsigned int numDisks;
+            unsigned int numPegs;
+            std::uint64_t pegs[MaxPegs];
+
+        //end of private
+    };
+}
+
+#endif // HANOI_BOARD_HPP_INCLUDED
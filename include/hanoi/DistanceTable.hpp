@@ -0,0 +1,115 @@
+#ifndef HANOI_DISTANCETABLE_HPP_INCLUDED
+#define HANOI_DISTANCETABLE_HPP_INCLUDED
+
+////////////////////////////////////////////////////////////
+// HEADERS
+////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include <string>
+#include "Board.hpp"
+#include "StateSearch.hpp"
+
+////////////////////////////////////////////////////////////
+
+namespace hanoi
+{
+    ////////////////////////////////////////////////////////////
+    ///
+    /// @brief 24-byte header at the start of a distance table, followed
+    /// by count entries of width bytes each (little endian)
+    ///
+    ////////////////////////////////////////////////////////////
+
+    struct DistanceTableHeader
+    {
+        char magic[4];
+        std::uint16_t version;
+        std::uint8_t numDisks;
+        std::uint8_t goal;
+        std::uint8_t width;
+        std::uint8_t reserved[7];
+        std::uint64_t count;
+    };
+
+    static_assert(sizeof(DistanceTableHeader) == 24, "DistanceTableHeader must stay 24 bytes");
+
+    const char DistanceTableMagic[4] = { 'H', 'N', 'O', 'D' };
+    const std::uint16_t DistanceTableVersion = 1;
+
+    /// Bytes per entry: the smallest of 1, 2 or 4 that holds 2^n - 1
+    unsigned int distanceWidth(unsigned int numDisks);
+
+    ////////////////////////////////////////////////////////////
+    ///
+    /// @brief Writes the number of moves from every 3-peg state to the
+    /// full tower on the goal peg, indexed by stateIndex
+    ///
+    /// Going from the largest disk down, a disk already on the current
+    /// target costs nothing; otherwise it costs 2^d moves and the target
+    /// of the smaller disks becomes the third peg. All states sharing the
+    /// digits of the largest disks share that prefix of the walk, so the
+    /// table is cut into prefix blocks that worker threads fill with a
+    /// recursive pass straight into the memory-mapped file. A thread
+    /// count of 0 uses every hardware thread.
+    ///
+    ////////////////////////////////////////////////////////////
+
+    bool writeDistanceTable(const std::string& path, unsigned int numDisks, Peg goal = 2, unsigned int threads = 0);
+
+    ////////////////////////////////////////////////////////////
+    ///
+    /// @brief Memory-mapped reader for distance tables
+    ///
+    /// Lookups read one entry in place; pages are loaded on first touch.
+    ///
+    ////////////////////////////////////////////////////////////
+
+    class DistanceTable
+    {
+        public:
+
+            DistanceTable();
+            ~DistanceTable();
+
+            /// Maps a table file and checks its header; returns false if it is not a valid table
+            bool open(const std::string& path);
+            void close();
+
+            bool isOpen() const { return mapping != nullptr; }
+
+            unsigned int getNumDisks() const { return header.numDisks; }
+            Peg getGoal() const { return header.goal; }
+            std::uint64_t size() const { return header.count; }
+
+            /// Moves left from the state with this index
+            std::uint32_t at(std::uint64_t index) const
+            {
+                switch (header.width)
+                {
+                    case 1: return entries[index];
+                    case 2: return reinterpret_cast<const std::uint16_t*>(entries)[index];
+                    default: return reinterpret_cast<const std::uint32_t*>(entries)[index];
+                }
+            }
+
+            /// Moves left from a board with the same number of disks
+            std::uint32_t distance(const Board& board) const { return at(stateIndex(board)); }
+
+        //end of public
+
+        private:
+
+            DistanceTable(const DistanceTable&);
+            DistanceTable& operator=(const DistanceTable&);
+
+            DistanceTableHeader header;
+            void* mapping;
+            std::size_t mappingSize;
+            const std::uint8_t* entries;
+
+        //end of private
+    };
+}
+
+#endif // HANOI_DISTANCETABLE_HPP_INCLUDED
@@ -0,0 +1,143 @@
+#ifndef HANOI_FRAMESTEWART_HPP_INCLUDED
+#define HANOI_FRAMESTEWART_HPP_INCLUDED
+
+////////////////////////////////////////////////////////////
+// HEADERS
+////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include "Board.hpp"
+#include "MoveSequence.hpp"
+
+////////////////////////////////////////////////////////////
+
+namespace hanoi
+{
+    ////////////////////////////////////////////////////////////
+    ///
+    /// @brief Frame-Stewart move counts and split points for every
+    /// disk count up to MaxDisks and peg count up to MaxPegs
+    ///
+    /// With p pegs, n disks are solved by moving the top k disks to a
+    /// free peg with all p pegs. The other n - k disks then go to the goal
+    /// with p - 1 pegs, and the k disks follow with p pegs again. The table
+    /// keeps the k that gives the fewest moves. It is built once, on
+    /// first use, and shared read-only by every thread.
+    ///
+    ////////////////////////////////////////////////////////////
+
+    class SplitTable
+    {
+        public:
+
+            /// The process-wide table, built on first call
+            static const SplitTable& get();
+
+            /// Moves needed for n disks on p pegs; saturates at UINT64_MAX
+            std::uint64_t cost(unsigned int numDisks, unsigned int numPegs) const { return costs[numPegs][numDisks]; }
+
+            /// Disks moved aside first; 0 when the 3-peg solution applies
+            unsigned int split(unsigned int numDisks, unsigned int numPegs) const { return splits[numPegs][numDisks]; }
+
+        //end of public
+
+        private:
+
+            SplitTable();
+
+            std::uint64_t costs[MaxPegs + 1][MaxDisks + 1];
+            std::uint8_t splits[MaxPegs + 1][MaxDisks + 1];
+
+        //end of private
+    };
+
+    ////////////////////////////////////////////////////////////
+    ///
+    /// @brief Lazy Frame-Stewart solution for any number of pegs
+    ///
+    /// Any move can be looked up by index in O(n + p) by walking down the
+    /// split tree. A Cursor streams the moves in order in O(1) amortized
+    /// time each, with a fixed-size stack and no allocation. With three
+    /// pegs the moves match MoveGenerator exactly.
+    ///
+    ////////////////////////////////////////////////////////////
+
+    class FrameStewartGenerator : public MoveSequence
+    {
+        public:
+
+            /// One subproblem: count disks starting at disk lowest, from source to destination using the pegs in mask
+            struct Frame
+            {
+                std::uint8_t count;
+                std::uint8_t lowest;
+                Peg source;
+                Peg destination;
+                std::uint16_t mask;
+                std::uint8_t stage;
+                std::uint64_t index;
+            };
+
+            class Cursor
+            {
+                public:
+
+                    Cursor(const FrameStewartGenerator& generator, std::uint64_t first = 0);
+
+                    bool done() const { return depth == 0; }
+
+                    /// Current move; advances to the next one
+                    Move next();
+
+                //end of public
+
+                private:
+
+                    void descend();
+
+                    const FrameStewartGenerator* generator;
+                    Frame stack[MaxDisks + MaxPegs + 2];
+                    unsigned int depth;
+
+                //end of private
+            };
+
+            /// Goal defaults to the last peg
+            FrameStewartGenerator(unsigned int numDisks, unsigned int numPegs);
+            FrameStewartGenerator(unsigned int numDisks, unsigned int numPegs, Peg from, Peg to);
+
+            unsigned int getNumDisks() const { return numDisks; }
+            unsigned int getNumPegs() const { return numPegs; }
+            Peg getFrom() const { return from; }
+            Peg getTo() const { return to; }
+
+            std::uint64_t size() const { return total; }
+            Move at(std::uint64_t index) const;
+            Move operator[](std::uint64_t index) const { return at(index); }
+
+            /// Board after the first movesDone moves, in O(n + p)
+            Board stateAfter(std::uint64_t movesDone) const;
+
+        //end of public
+
+        private:
+
+            Frame root() const;
+            bool isLeaf(const Frame& frame) const;
+            std::uint64_t frameSize(const Frame& frame) const;
+            Frame child(const Frame& frame, unsigned int stage) const;
+            unsigned int childStage(const Frame& frame, std::uint64_t& index) const;
+            Move leafMove(const Frame& frame, std::uint64_t index) const;
+
+            unsigned int numDisks;
+            unsigned int numPegs;
+            Peg from;
+            Peg to;
+            std::uint64_t total;
+            const SplitTable& table;
+
+        //end of private
+    };
+}
+
+#endif // HANOI_FRAMESTEWART_HPP_INCLUDED
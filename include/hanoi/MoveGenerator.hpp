@@ -0,0 +1,140 @@
+#ifndef HANOI_MOVEGENERATOR_HPP_INCLUDED
+#define HANOI_MOVEGENERATOR_HPP_INCLUDED
+
+////////////////////////////////////////////////////////////
+// HEADERS
+////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include <iterator>
+
+////////////////////////////////////////////////////////////
+
+namespace hanoi
+{
+    typedef std::uint8_t Peg;
+
+    ////////////////////////////////////////////////////////////
+    ///
+    /// @brief A single move: disk 0 is the smallest disk
+    ///
+    ////////////////////////////////////////////////////////////
+
+    struct Move
+    {
+        Peg source;
+        Peg destination;
+        std::uint8_t disk;
+    };
+
+    ////////////////////////////////////////////////////////////
+    ///
+    /// @brief Closed-form generator for the optimal 3-peg solution
+    ///
+    /// Move k (1-based) moves disk d = ctz(k). That disk has already
+    /// moved j = k >> (d + 1) times and always cycles through the pegs
+    /// in the same direction, so both pegs follow from j mod 3.
+    /// Every lookup is O(1), without recursion or allocation.
+    ///
+    ////////////////////////////////////////////////////////////
+
+    class MoveGenerator
+    {
+        public:
+
+            class iterator
+            {
+                public:
+
+                    typedef std::forward_iterator_tag iterator_category;
+                    typedef Move value_type;
+                    typedef std::int64_t difference_type;
+                    typedef const Move* pointer;
+                    typedef Move reference;
+
+                    iterator(const MoveGenerator* generator, std::uint64_t index)
+                        : generator(generator), index(index) {}
+
+                    Move operator*() const { return (*generator)[index]; }
+                    iterator& operator++() { ++index; return *this; }
+                    iterator operator++(int) { iterator old = *this; ++index; return old; }
+                    bool operator==(const iterator& other) const { return index == other.index; }
+                    bool operator!=(const iterator& other) const { return index != other.index; }
+
+                //end of public
+
+                private:
+
+                    const MoveGenerator* generator;
+                    std::uint64_t index;
+
+                //end of private
+            };
+
+            MoveGenerator(unsigned int numDisks, Peg from = 0, Peg to = 2)
+                : numDisks(numDisks)
+            {
+                pegs[0] = from;
+                pegs[1] = static_cast<Peg>(3 - from - to);
+                pegs[2] = to;
+                for (int parity = 0; parity < 2; ++parity)
+                {
+                    // Disks whose distance to the bottom is even turn 0->2->1,
+                    // the others 0->1->2.
+                    const int direction = parity ? 2 : 1;
+                    for (int j = 0; j < 3; ++j)
+                    {
+                        table[parity][j][0] = pegs[(j * direction) % 3];
+                        table[parity][j][1] = pegs[((j + 1) * direction) % 3];
+                    }
+                }
+            }
+
+            unsigned int getNumDisks() const
+            {
+                return numDisks;
+            }
+
+            /// Real peg for 0 = start, 1 = auxiliary, 2 = goal
+            Peg getPeg(int role) const
+            {
+                return pegs[role];
+            }
+
+            /// Number of moves in the solution, 2^n - 1
+            std::uint64_t size() const
+            {
+                return numDisks >= 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << numDisks) - 1;
+            }
+
+            /// Move at a 0-based index; index must be below size()
+            Move operator[](std::uint64_t index) const
+            {
+                const std::uint64_t k = index + 1;
+                const unsigned int disk = __builtin_ctzll(k);
+                const unsigned int j = ((k >> disk) >> 1) % 3;
+                const std::uint8_t* entry = table[(numDisks - disk) & 1][j];
+
+                Move move;
+                move.source = entry[0];
+                move.destination = entry[1];
+                move.disk = static_cast<std::uint8_t>(disk);
+                return move;
+            }
+
+            iterator begin() const { return iterator(this, 0); }
+            iterator end() const { return iterator(this, size()); }
+
+        //end of public
+
+        private:
+
+            unsigned int numDisks;
+            Peg pegs[3];
+            std::uint8_t table[2][3][2];
+
+        //end of private
+    };
+}
+
+#endif // HANOI_MOVEGENERATOR_HPP_INCLUDED
@@ -0,0 +1,47 @@
+#ifndef HANOI_MOVEKERNEL_HPP_INCLUDED
+#define HANOI_MOVEKERNEL_HPP_INCLUDED
+
+////////////////////////////////////////////////////////////
+// HEADERS
+////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include "MoveGenerator.hpp"
+#include "MoveSequence.hpp"
+
+////////////////////////////////////////////////////////////
+
+namespace hanoi
+{
+    enum KernelPath
+    {
+        ScalarKernel,
+        Sse2Kernel,
+        Avx2Kernel
+    };
+
+    ////////////////////////////////////////////////////////////
+    ///
+    /// @brief Fills out[0, count) with the packed moves starting at
+    /// index first, 8 (SSE2) or 16 (AVX2) moves per batch
+    ///
+    /// In a batch aligned to L = 8 or 16, lane j > 0 moves disk ctz(j)
+    /// whatever the batch is, and that disk's move count mod 3 depends
+    /// only on the batch number mod 3. The lanes therefore compute pegs
+    /// with mod-3 arithmetic on 16-bit values. Only lane 0, whose disk
+    /// is ctz of the batch base, is computed in scalar code.
+    ///
+    /// The widest path the CPU supports is chosen at runtime.
+    ///
+    ////////////////////////////////////////////////////////////
+
+    void computeMoves(const MoveGenerator& generator, std::uint64_t first, std::uint64_t count, PackedMove* out);
+
+    /// Same as above on a forced path; falls back to scalar if the CPU lacks it
+    void computeMoves(const MoveGenerator& generator, std::uint64_t first, std::uint64_t count, PackedMove* out, KernelPath path);
+
+    KernelPath bestKernelPath();
+    const char* kernelPathName(KernelPath path);
+}
+
+#endif // HANOI_MOVEKERNEL_HPP_INCLUDED
@@ -0,0 +1,155 @@
+#ifndef HANOI_MOVELOG_HPP_INCLUDED
+#define HANOI_MOVELOG_HPP_INCLUDED
+
+////////////////////////////////////////////////////////////
+// HEADERS
+////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "MoveSequence.hpp"
+
+////////////////////////////////////////////////////////////
+
+namespace hanoi
+{
+    ////////////////////////////////////////////////////////////
+    ///
+    /// @brief 24-byte header at the start of a move log, followed
+    /// by count PackedMove records (little endian)
+    ///
+    ////////////////////////////////////////////////////////////
+
+    struct MoveLogHeader
+    {
+        char magic[4];
+        std::uint16_t version;
+        std::uint8_t numDisks;
+        std::uint8_t numPegs;
+        std::uint8_t from;
+        std::uint8_t to;
+        std::uint8_t reserved[6];
+        std::uint64_t count;
+    };
+
+    static_assert(sizeof(MoveLogHeader) == 24, "MoveLogHeader must stay 24 bytes");
+
+    const char MoveLogMagic[4] = { 'H', 'N', 'O', 'I' };
+    const std::uint16_t MoveLogVersion = 1;
+
+    /// Most records a log can hold before its size overflows a 64-bit file offset
+    const std::uint64_t MaxLogMoves = (std::uint64_t(INT64_MAX) - sizeof(MoveLogHeader)) / sizeof(PackedMove);
+
+    MoveLogHeader makeMoveLogHeader(unsigned int numDisks, Peg from, Peg to, unsigned int numPegs, std::uint64_t count);
+
+    ////////////////////////////////////////////////////////////
+    ///
+    /// @brief Buffered writer for move logs
+    ///
+    ////////////////////////////////////////////////////////////
+
+    class MoveLogWriter
+    {
+        public:
+
+            MoveLogWriter();
+            ~MoveLogWriter();
+
+            bool open(const std::string& path, unsigned int numDisks, Peg from = 0, Peg to = 2, unsigned int numPegs = 3);
+
+            /// Writes the buffered records and the final count; returns false on I/O error
+            bool close();
+
+            bool isOpen() const { return file != nullptr; }
+
+            void write(const Move& move)
+            {
+                write(packMove(move));
+            }
+
+            void write(PackedMove move)
+            {
+                buffer.push_back(move);
+                if (buffer.size() == BufferSize)
+                {
+                    flush();
+                }
+            }
+
+            void write(const PackedMove* moves, std::uint64_t count);
+
+            std::uint64_t getCount() const { return header.count + buffer.size(); }
+
+        //end of public
+
+        private:
+
+            static const std::size_t BufferSize = 1 << 16;
+
+            MoveLogWriter(const MoveLogWriter&);
+            MoveLogWriter& operator=(const MoveLogWriter&);
+
+            void flush();
+
+            std::FILE* file;
+            MoveLogHeader header;
+            std::vector<PackedMove> buffer;
+            bool failed;
+
+        //end of private
+    };
+
+    ////////////////////////////////////////////////////////////
+    ///
+    /// @brief Memory-mapped reader for move logs
+    ///
+    /// Records are used in place, so even logs larger than memory can be
+    /// iterated or accessed at random without loading them.
+    ///
+    ////////////////////////////////////////////////////////////
+
+    class MoveLogReader : public MoveSequence
+    {
+        public:
+
+            MoveLogReader();
+            ~MoveLogReader();
+
+            /// Maps a log file and checks its header; returns false if it is not a
+            /// valid log or describes no playable problem (1 to MaxDisks disks,
+            /// 3 to MaxPegs pegs, two different pegs in range)
+            bool open(const std::string& path);
+            void close();
+
+            bool isOpen() const { return mapping != nullptr; }
+
+            const MoveLogHeader& getHeader() const { return header; }
+            unsigned int getNumDisks() const { return header.numDisks; }
+            unsigned int getNumPegs() const { return header.numPegs; }
+            Peg getFrom() const { return header.from; }
+            Peg getTo() const { return header.to; }
+
+            std::uint64_t size() const { return header.count; }
+            Move at(std::uint64_t index) const { return unpackMove(records[index]); }
+            Move operator[](std::uint64_t index) const { return unpackMove(records[index]); }
+            const PackedMove* data() const { return records; }
+
+        //end of public
+
+        private:
+
+            MoveLogReader(const MoveLogReader&);
+            MoveLogReader& operator=(const MoveLogReader&);
+
+            MoveLogHeader header;
+            void* mapping;
+            std::size_t mappingSize;
+            const PackedMove* records;
+
+        //end of private
+    };
+}
+
+#endif // HANOI_MOVELOG_HPP_INCLUDED
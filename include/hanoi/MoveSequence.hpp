@@ -0,0 +1,88 @@
+#ifndef HANOI_MOVESEQUENCE_HPP_INCLUDED
+#define HANOI_MOVESEQUENCE_HPP_INCLUDED
+
+////////////////////////////////////////////////////////////
+// HEADERS
+////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include <vector>
+#include "MoveGenerator.hpp"
+
+////////////////////////////////////////////////////////////
+
+namespace hanoi
+{
+    ////////////////////////////////////////////////////////////
+    ///
+    /// @brief Packed 16-bit move: source in bits 0-3, destination
+    /// in bits 4-7 and disk in bits 8-15
+    ///
+    ////////////////////////////////////////////////////////////
+
+    typedef std::uint16_t PackedMove;
+
+    inline PackedMove packMove(const Move& move)
+    {
+        return static_cast<PackedMove>(move.source | (move.destination << 4) | (move.disk << 8));
+    }
+
+    inline Move unpackMove(PackedMove packed)
+    {
+        Move move;
+        move.source = packed & 0x0F;
+        move.destination = (packed >> 4) & 0x0F;
+        move.disk = static_cast<std::uint8_t>(packed >> 8);
+        return move;
+    }
+
+    ////////////////////////////////////////////////////////////
+    ///
+    /// @brief Base class for anything the visualizer can play back
+    ///
+    ////////////////////////////////////////////////////////////
+
+    class MoveSequence
+    {
+        public:
+
+            virtual ~MoveSequence() {}
+            virtual std::uint64_t size() const = 0;
+            virtual Move at(std::uint64_t index) const = 0;
+
+        //end of public
+    };
+
+    ////////////////////////////////////////////////////////////
+    ///
+    /// @brief In-memory sequence of packed moves
+    ///
+    ////////////////////////////////////////////////////////////
+
+    class MoveList : public MoveSequence
+    {
+        public:
+
+            std::uint64_t size() const { return moves.size(); }
+            Move at(std::uint64_t index) const { return unpackMove(moves[index]); }
+
+            void push_back(const Move& move) { moves.push_back(packMove(move)); }
+            void reserve(std::uint64_t count) { moves.reserve(count); }
+            void resize(std::uint64_t count) { moves.resize(count); }
+            void clear() { moves.clear(); }
+            bool empty() const { return moves.empty(); }
+
+            PackedMove* data() { return moves.data(); }
+            const PackedMove* data() const { return moves.data(); }
+
+        //end of public
+
+        private:
+
+            std::vector<PackedMove> moves;
+
+        //end of private
+    };
+}
+
+#endif // HANOI_MOVESEQUENCE_HPP_INCLUDED
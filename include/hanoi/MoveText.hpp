@@ -0,0 +1,102 @@
+#ifndef HANOI_MOVETEXT_HPP_INCLUDED
+#define HANOI_MOVETEXT_HPP_INCLUDED
+
+////////////////////////////////////////////////////////////
+// HEADERS
+////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "MoveSequence.hpp"
+
+////////////////////////////////////////////////////////////
+
+namespace hanoi
+{
+    ////////////////////////////////////////////////////////////
+    ///
+    /// @brief Buffered writer for moves as text lines
+    ///
+    /// Compact lines are "A C 3": source, destination and disk. Verbose
+    /// lines match the visualizer: "[12/15] Mover disco 0 de A a C".
+    /// Both number disks as the visualizer does, 0 being the largest,
+    /// so the same move reads the same in either style.
+    /// Lines are formatted with std::to_chars into one reusable buffer
+    /// that is written in large blocks, so a long export costs a few
+    /// syscalls per megabyte rather than one per line.
+    ///
+    ////////////////////////////////////////////////////////////
+
+    class MoveTextWriter
+    {
+        public:
+
+            enum Style { Compact, Verbose };
+
+            /// Longest line either style can produce, newline included
+            static const std::size_t MaxLine = 96;
+
+            MoveTextWriter();
+            ~MoveTextWriter();
+
+            /// Creates a file; total is shown in verbose lines when not 0
+            bool open(const std::string& path, Style style, unsigned int numDisks, std::uint64_t total = 0);
+
+            /// Writes to an already open stream, such as stdout, without taking ownership
+            bool open(std::FILE* stream, Style style, unsigned int numDisks, std::uint64_t total = 0);
+
+            /// Writes what is buffered and closes the file if it was opened by path; false on I/O error
+            bool close();
+
+            bool isOpen() const { return file != nullptr; }
+
+            /// Formats one line into out (at least MaxLine bytes) and returns its length
+            std::size_t format(char* out, const Move& move, std::uint64_t index) const;
+
+            /// Buffers the line for the move at index
+            void write(const Move& move, std::uint64_t index)
+            {
+                if (buffer.size() - used < MaxLine)
+                {
+                    flush();
+                }
+                used += format(buffer.data() + used, move, index);
+            }
+
+            /// Buffers any other text as is
+            void write(const char* text, std::size_t length);
+
+            /// Buffers count moves numbered from firstIndex
+            void write(const PackedMove* moves, std::uint64_t count, std::uint64_t firstIndex);
+
+            /// Hands the buffered lines to the stream
+            void flush();
+
+        //end of public
+
+        private:
+
+            static const std::size_t BufferSize = 1 << 20;
+
+            MoveTextWriter(const MoveTextWriter&);
+            MoveTextWriter& operator=(const MoveTextWriter&);
+
+            std::FILE* file;
+            bool ownsFile;
+            Style style;
+            unsigned int numDisks;
+            std::uint64_t total;
+            std::vector<char> buffer;
+            std::size_t used;
+            bool failed;
+
+        //end of private
+    };
+
+    /// Formats one line of the given style without a writer, e.g. for on-screen text
+    std::size_t formatMoveText(char* out, const Move& move, std::uint64_t index, MoveTextWriter::Style style, unsigned int numDisks, std::uint64_t total = 0);
+}
+
+#endif // HANOI_MOVETEXT_HPP_INCLUDED
@@ -0,0 +1,88 @@
+#ifndef HANOI_MOVEVERIFIER_HPP_INCLUDED
+#define HANOI_MOVEVERIFIER_HPP_INCLUDED
+
+////////////////////////////////////////////////////////////
+// HEADERS
+////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include <string>
+#include "Board.hpp"
+#include "MoveSequence.hpp"
+
+////////////////////////////////////////////////////////////
+
+namespace hanoi
+{
+    ////////////////////////////////////////////////////////////
+    ///
+    /// @brief Checks a move stream against a start and goal board as it
+    /// arrives
+    ///
+    /// Moves are applied to plain peg masks, a few bit operations each,
+    /// so a packed stream is checked at memory speed with no per-move
+    /// branches beyond the legality tests. Input can come in pieces of any
+    /// size: packed records, or compact text lines ("A C 3", disk 0 the
+    /// largest, see MoveTextWriter) that may be split anywhere between calls. The
+    /// first rejected move stops the check and keeps its index.
+    ///
+    ////////////////////////////////////////////////////////////
+
+    class MoveVerifier
+    {
+        public:
+
+            enum Status
+            {
+                Valid,
+                BadPeg,             ///< Peg out of range, or source equal to destination
+                EmptySource,
+                LargerOnSmaller,
+                WrongDisk,          ///< The disk named is not the top disk of the source
+                Malformed,          ///< A text line could not be parsed
+                NotAtGoal,          ///< Every move was legal but the goal was not reached
+                NotOptimal          ///< The goal was reached with more moves than needed
+            };
+
+            /// optimal = 0 skips the optimality check
+            MoveVerifier(const Board& start, const Board& goal, std::uint64_t optimal = 0);
+
+            /// Applies moves until one is rejected; false once the stream is rejected
+            bool feed(const PackedMove* moves, std::uint64_t count);
+            bool feed(const Move& move) { const PackedMove packed = packMove(move); return feed(&packed, 1); }
+
+            /// Same for compact text; a line cut at the end waits for the next call
+            bool feedText(const char* text, std::size_t length);
+
+            /// Ends the stream and checks the goal and the move count
+            Status finish();
+
+            Status getStatus() const { return status; }
+
+            /// Moves accepted so far; when rejected, the index of the first bad move
+            std::uint64_t getCount() const { return count; }
+
+            /// Board after the accepted moves
+            Board getBoard() const;
+
+        //end of public
+
+        private:
+
+            bool reject(Status reason) { status = reason; return false; }
+            bool parseLine(const char* begin, const char* end);
+
+            std::uint64_t pegs[MaxPegs];
+            Board goal;
+            unsigned int numPegs;
+            unsigned int numDisks;
+            std::uint64_t optimal;
+            std::uint64_t count;
+            Status status;
+            std::string pending;
+
+        //end of private
+    };
+}
+
+#endif // HANOI_MOVEVERIFIER_HPP_INCLUDED
@@ -0,0 +1,60 @@
+#ifndef HANOI_PARALLELGENERATOR_HPP_INCLUDED
+#define HANOI_PARALLELGENERATOR_HPP_INCLUDED
+
+////////////////////////////////////////////////////////////
+// HEADERS
+////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include <string>
+#include "FrameStewart.hpp"
+#include "MoveGenerator.hpp"
+#include "MoveSequence.hpp"
+
+////////////////////////////////////////////////////////////
+
+namespace hanoi
+{
+    ////////////////////////////////////////////////////////////
+    ///
+    /// @brief Fills out[0, count) with the packed moves starting at
+    /// index first
+    ///
+    /// Every move index is independent, so the range is cut into one
+    /// contiguous slice per worker thread. Each worker writes only its own
+    /// slice, so no locks are needed and the output is always identical.
+    /// A thread count of 0 uses every hardware thread.
+    ///
+    ////////////////////////////////////////////////////////////
+
+    void generateMoves(const MoveGenerator& generator, std::uint64_t first, std::uint64_t count, PackedMove* out, unsigned int threads = 0);
+
+    ////////////////////////////////////////////////////////////
+    ///
+    /// @brief Writes the full solution as a move log
+    ///
+    /// The file is sized up front and every worker writes its own slice
+    /// with pwrite, so the writes need no coordination either.
+    ///
+    ////////////////////////////////////////////////////////////
+
+    bool writeSolutionLog(const std::string& path, unsigned int numDisks, Peg from = 0, Peg to = 2, unsigned int threads = 0);
+
+    ////////////////////////////////////////////////////////////
+    ///
+    /// @brief Same as above for the Frame-Stewart solution with any
+    /// number of pegs
+    ///
+    /// Each worker seeks its slice start once with a Cursor and then
+    /// streams in order.
+    ///
+    ////////////////////////////////////////////////////////////
+
+    void generateMoves(const FrameStewartGenerator& generator, std::uint64_t first, std::uint64_t count, PackedMove* out, unsigned int threads = 0);
+    bool writeSolutionLog(const std::string& path, const FrameStewartGenerator& generator, unsigned int threads = 0);
+
+    /// Number of workers used for a given thread setting and amount of work
+    unsigned int workerCount(unsigned int threads, std::uint64_t count);
+}
+
+#endif // HANOI_PARALLELGENERATOR_HPP_INCLUDED
@@ -0,0 +1,40 @@
+#ifndef HANOI_STATEQUERY_HPP_INCLUDED
+#define HANOI_STATEQUERY_HPP_INCLUDED
+
+////////////////////////////////////////////////////////////
+// HEADERS
+////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include "Board.hpp"
+
+////////////////////////////////////////////////////////////
+
+namespace hanoi
+{
+    ////////////////////////////////////////////////////////////
+    ///
+    /// @brief Board of the optimal 3-peg solution after a number of moves
+    ///
+    /// Reads the bits of movesDone from the largest disk down: a 0 leaves
+    /// the disk on the current source, a 1 puts it on the current goal,
+    /// and the remaining disks continue with the pegs swapped. O(n), no
+    /// replay.
+    ///
+    ////////////////////////////////////////////////////////////
+
+    Board stateAfter(unsigned int numDisks, std::uint64_t movesDone, Peg from = 0, Peg to = 2);
+
+    ////////////////////////////////////////////////////////////
+    ///
+    /// @brief Inverse of stateAfter: the number of moves that lead to a
+    /// board along the optimal solution
+    ///
+    /// Returns false if the board is not part of that solution.
+    ///
+    ////////////////////////////////////////////////////////////
+
+    bool movesDoneFor(const Board& board, std::uint64_t& movesDone, Peg from = 0, Peg to = 2);
+}
+
+#endif // HANOI_STATEQUERY_HPP_INCLUDED
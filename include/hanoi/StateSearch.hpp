@@ -0,0 +1,65 @@
+#ifndef HANOI_STATESEARCH_HPP_INCLUDED
+#define HANOI_STATESEARCH_HPP_INCLUDED
+
+////////////////////////////////////////////////////////////
+// HEADERS
+////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include "Board.hpp"
+#include "MoveSequence.hpp"
+
+////////////////////////////////////////////////////////////
+
+namespace hanoi
+{
+    /// Largest disk count the 3-peg state space search accepts (3^20 states, 0.9 GB)
+    const unsigned int MaxSearchDisks = 20;
+
+    /// Pairs of pegs a disk may move between, in both directions
+    enum PegLink
+    {
+        LinkAB = 1 << 0,
+        LinkAC = 1 << 1,
+        LinkBC = 1 << 2,
+        AllLinks = LinkAB | LinkAC | LinkBC
+    };
+
+    ////////////////////////////////////////////////////////////
+    ///
+    /// @brief Index of a 3-peg board in [0, 3^n): digit d in base 3 is
+    /// the peg of disk d
+    ///
+    ////////////////////////////////////////////////////////////
+
+    std::uint64_t stateIndex(const Board& board);
+
+    /// Inverse of stateIndex
+    Board boardFromIndex(unsigned int numDisks, std::uint64_t index);
+
+    /// 3^n, for n up to 40
+    std::uint64_t stateCount(unsigned int numDisks);
+
+    ////////////////////////////////////////////////////////////
+    ///
+    /// @brief Shortest move sequence between any two legal 3-peg boards
+    ///
+    /// Breadth-first search over the 3^n states. Each state keeps only
+    /// 2 bits: 3 while unvisited, else its depth mod 3. That is enough to
+    /// rebuild the path backwards from the goal, since every neighbour of
+    /// a state at depth d has depth d - 1, d or d + 1, and only the
+    /// parents have d - 1 mod 3. Levels with a large frontier are split
+    /// between worker threads that claim states with an atomic
+    /// compare-and-swap. Links restricts the moves, e.g. LinkAB | LinkBC
+    /// for the adjacent-pegs variant; a thread count of 0 uses every
+    /// hardware thread.
+    ///
+    /// Returns false if the boards are not 3-peg boards with the same
+    /// number of disks, exceed MaxSearchDisks or the goal is unreachable.
+    ///
+    ////////////////////////////////////////////////////////////
+
+    bool findShortestPath(const Board& start, const Board& goal, MoveList& moves, unsigned int links = AllLinks, unsigned int threads = 0);
+}
+
+#endif // HANOI_STATESEARCH_HPP_INCLUDED
@@ -0,0 +1,78 @@
+#ifndef HANOI_STATICSOLUTION_HPP_INCLUDED
+#define HANOI_STATICSOLUTION_HPP_INCLUDED
+
+////////////////////////////////////////////////////////////
+// HEADERS
+////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include "MoveSequence.hpp"
+
+////////////////////////////////////////////////////////////
+
+namespace hanoi
+{
+    /// Largest disk count with a compiled-in table
+    const unsigned int MaxStaticDisks = 15;
+
+    /// Packed 3-peg solution from peg 0 to peg 2, built at compile time;
+    /// 2^n - 1 moves, or nullptr when n is 0 or above MaxStaticDisks
+    const PackedMove* staticSolutionTable(unsigned int numDisks);
+
+    ////////////////////////////////////////////////////////////
+    ///
+    /// @brief Optimal 3-peg solution read from a table in the executable
+    ///
+    /// The tables for 1 to MaxStaticDisks disks (about 128 KB together)
+    /// are computed by the compiler, so playing one back costs no
+    /// generation and no allocation. Other start and goal pegs are a
+    /// relabeling of the table's pegs, applied on lookup. For more disks
+    /// or pegs, use MoveGenerator or FrameStewartGenerator.
+    ///
+    ////////////////////////////////////////////////////////////
+
+    class StaticSolution : public MoveSequence
+    {
+        public:
+
+            /// An empty sequence until assigned a covered problem
+            StaticSolution() : moves(nullptr), count(0) {}
+
+            /// numDisks must pass covers(numDisks, 3)
+            StaticSolution(unsigned int numDisks, Peg from = 0, Peg to = 2)
+                : moves(staticSolutionTable(numDisks)),
+                  count(moves ? (std::uint64_t(1) << numDisks) - 1 : 0)
+            {
+                pegs[0] = from;
+                pegs[1] = static_cast<Peg>(3 - from - to);
+                pegs[2] = to;
+            }
+
+            static bool covers(unsigned int numDisks, unsigned int numPegs)
+            {
+                return numPegs == 3 && numDisks >= 1 && numDisks <= MaxStaticDisks;
+            }
+
+            std::uint64_t size() const { return count; }
+
+            Move at(std::uint64_t index) const
+            {
+                Move move = unpackMove(moves[index]);
+                move.source = pegs[move.source];
+                move.destination = pegs[move.destination];
+                return move;
+            }
+
+        //end of public
+
+        private:
+
+            const PackedMove* moves;
+            std::uint64_t count;
+            Peg pegs[3];
+
+        //end of private
+    };
+}
+
+#endif // HANOI_STATICSOLUTION_HPP_INCLUDED
@@ -32,5 +32,7 @@
 #include "Button.hpp"
 #include "RectButton.hpp"
 #include "EllipseButton.hpp"
+#include "ButtonRouter.hpp"
+#include "ButtonBatch.hpp"
 
 #endif // SFMLBUTTON_HPP_INCLUDED
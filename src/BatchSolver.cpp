@@ -0,0 +1,227 @@
+#include "../include/BatchSolver.hpp"
+#include "../include/hanoi/FrameStewart.hpp"
+#include "../include/hanoi/MoveLog.hpp"
+#include "../include/hanoi/MoveText.hpp"
+#include "../include/hanoi/MoveVerifier.hpp"
+#include "../include/hanoi/ParallelGenerator.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+////////////////////////////////////////////////////////////
+///
+/// @category Batch solving
+///
+////////////////////////////////////////////////////////////
+
+namespace
+{
+    // Moves generated per round; big enough to keep every worker busy
+    const std::uint64_t ChunkMoves = 1 << 20;
+
+    // Bytes read per round when verifying text
+    const std::size_t ReadBytes = 1 << 20;
+
+    const char* describe(hanoi::MoveVerifier::Status status)
+    {
+        switch (status)
+        {
+            case hanoi::MoveVerifier::Valid: return "solucion valida";
+            case hanoi::MoveVerifier::BadPeg: return "torre invalida";
+            case hanoi::MoveVerifier::EmptySource: return "la torre de origen esta vacia";
+            case hanoi::MoveVerifier::LargerOnSmaller: return "disco grande sobre uno chico";
+            case hanoi::MoveVerifier::WrongDisk: return "el disco no es el de arriba";
+            case hanoi::MoveVerifier::Malformed: return "linea ilegible";
+            case hanoi::MoveVerifier::NotAtGoal: return "no termina en la meta";
+            default: return "correcta pero no optima";
+        }
+    }
+
+    template <typename Generator>
+    bool streamMoves(const Generator& generator, const BatchOptions& options, std::FILE* out)
+    {
+        const std::uint64_t total = generator.size();
+        if (options.format == BatchOptions::Binary)
+        {
+            const hanoi::MoveLogHeader header = hanoi::makeMoveLogHeader(options.numDisks, options.from, options.to, options.numPegs, total);
+            if (std::fwrite(&header, sizeof(header), 1, out) != 1)
+            {
+                return false;
+            }
+        }
+
+        hanoi::MoveTextWriter text;
+        if (options.format != BatchOptions::Binary)
+        {
+            const hanoi::MoveTextWriter::Style style = options.format == BatchOptions::VerboseText
+                ? hanoi::MoveTextWriter::Verbose : hanoi::MoveTextWriter::Compact;
+            text.open(out, style, options.numDisks, total);
+        }
+
+        std::vector<hanoi::PackedMove> chunk(total < ChunkMoves ? total : ChunkMoves);
+        for (std::uint64_t index = 0; index < total; index += chunk.size())
+        {
+            const std::uint64_t count = total - index < chunk.size() ? total - index : chunk.size();
+            hanoi::generateMoves(generator, index, count, chunk.data(), options.threads);
+
+            if (options.format != BatchOptions::Binary)
+            {
+                text.write(chunk.data(), count, index);
+            }
+            else if (std::fwrite(chunk.data(), sizeof(hanoi::PackedMove), count, out) != count)
+            {
+                return false;
+            }
+        }
+        if (text.isOpen() && !text.close())
+        {
+            return false;
+        }
+        return std::fflush(out) == 0;
+    }
+
+    // True when the file starts like a move log, valid header or not
+    bool hasLogMagic(const std::string& path)
+    {
+        char magic[sizeof(hanoi::MoveLogMagic)] = {};
+        std::FILE* in = std::fopen(path.c_str(), "rb");
+        const bool read = in && std::fread(magic, 1, sizeof(magic), in) == sizeof(magic);
+        if (in)
+        {
+            std::fclose(in);
+        }
+        return read && std::memcmp(magic, hanoi::MoveLogMagic, sizeof(magic)) == 0;
+    }
+}
+
+////////////////////////////////////////////////////////////
+
+int runBatch(const BatchOptions& options)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    const hanoi::FrameStewartGenerator frameStewart(options.numDisks, options.numPegs, options.from, options.to);
+    const hanoi::MoveGenerator threePegs(options.numDisks, options.from, options.to);
+    const std::uint64_t total = frameStewart.size();
+
+    if (options.format == BatchOptions::Binary && total > hanoi::MaxLogMoves)
+    {
+        std::fprintf(stderr, "%llu movimientos no caben en un registro binario (maximo %llu)\n",
+                     static_cast<unsigned long long>(total), static_cast<unsigned long long>(hanoi::MaxLogMoves));
+        return 1;
+    }
+
+    bool ok;
+    if (options.format == BatchOptions::Binary && !options.outPath.empty())
+    {
+        // Known size up front: every worker writes its own slice of the file
+        ok = options.numPegs == 3
+            ? hanoi::writeSolutionLog(options.outPath, options.numDisks, options.from, options.to, options.threads)
+            : hanoi::writeSolutionLog(options.outPath, frameStewart, options.threads);
+    }
+    else
+    {
+        std::FILE* out = options.outPath.empty() ? stdout : std::fopen(options.outPath.c_str(), "wb");
+        if (!out)
+        {
+            std::fprintf(stderr, "No se pudo crear %s\n", options.outPath.c_str());
+            return 1;
+        }
+        ok = options.numPegs == 3 ? streamMoves(threePegs, options, out) : streamMoves(frameStewart, options, out);
+        if (out != stdout && std::fclose(out) != 0)
+        {
+            ok = false;
+        }
+    }
+
+    if (!ok)
+    {
+        std::fprintf(stderr, "Error al escribir los movimientos\n");
+        return 1;
+    }
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::fprintf(stderr, "%u discos, %u torres: %llu movimientos en %.3f s (%.0f movimientos/s)\n",
+                 options.numDisks, options.numPegs, static_cast<unsigned long long>(total), seconds,
+                 seconds > 0 ? total / seconds : 0.0);
+    return 0;
+}
+
+////////////////////////////////////////////////////////////
+
+int runVerify(const std::string& path, const BatchOptions& options)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    hanoi::MoveLogReader log;
+    const bool binary = path != "-" && log.open(path);
+    if (!binary && path != "-" && hasLogMagic(path))
+    {
+        // A log whose header MoveLogReader refused: bad disk or peg counts
+        std::fprintf(stderr, "Cabecera de registro invalida en %s\n", path.c_str());
+        return 1;
+    }
+    const unsigned int numDisks = binary ? log.getNumDisks() : options.numDisks;
+    const unsigned int numPegs = binary ? log.getNumPegs() : options.numPegs;
+    const hanoi::Peg from = binary ? log.getFrom() : options.from;
+    const hanoi::Peg to = binary ? log.getTo() : options.to;
+    if (numDisks == 0 || numDisks > hanoi::MaxDisks)
+    {
+        std::fprintf(stderr, "Numero de discos invalido en %s: %u (1 a %u)\n", path.c_str(), numDisks, hanoi::MaxDisks);
+        return 1;
+    }
+    if (numPegs < 3 || numPegs > hanoi::MaxPegs || from >= numPegs || to >= numPegs || from == to)
+    {
+        std::fprintf(stderr, "Torres invalidas en %s\n", path.c_str());
+        return 1;
+    }
+
+    const std::uint64_t optimal = hanoi::FrameStewartGenerator(numDisks, numPegs, from, to).size();
+    hanoi::MoveVerifier verifier(hanoi::Board(numDisks, numPegs, from), hanoi::Board(numDisks, numPegs, to), optimal);
+
+    if (binary)
+    {
+        verifier.feed(log.data(), log.size());
+    }
+    else
+    {
+        std::FILE* in = path == "-" ? stdin : std::fopen(path.c_str(), "rb");
+        if (!in)
+        {
+            std::fprintf(stderr, "No se pudo abrir %s\n", path.c_str());
+            return 1;
+        }
+        std::vector<char> buffer(ReadBytes);
+        std::size_t length;
+        while ((length = std::fread(buffer.data(), 1, buffer.size(), in)) > 0 && verifier.feedText(buffer.data(), length))
+        {
+        }
+        const bool failed = std::ferror(in) != 0;
+        if (in != stdin)
+        {
+            std::fclose(in);
+        }
+        if (failed)
+        {
+            std::fprintf(stderr, "Error al leer %s\n", path.c_str());
+            return 1;
+        }
+    }
+
+    const hanoi::MoveVerifier::Status status = verifier.finish();
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const unsigned long long count = verifier.getCount();
+
+    if (status == hanoi::MoveVerifier::Valid || status == hanoi::MoveVerifier::NotAtGoal || status == hanoi::MoveVerifier::NotOptimal)
+    {
+        std::fprintf(stderr, "Verificacion: %s, %llu movimientos (optimo %llu)", describe(status), count, static_cast<unsigned long long>(optimal));
+    }
+    else
+    {
+        std::fprintf(stderr, "Movimiento invalido en la operacion %llu: %s", count + 1, describe(status));
+    }
+    std::fprintf(stderr, ", %.3f s (%.0f movimientos/s)\n", seconds, seconds > 0 ? count / seconds : 0.0);
+    return status == hanoi::MoveVerifier::Valid ? 0 : 2;
+}
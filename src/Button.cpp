@@ -26,6 +26,7 @@
 // HEADERS
 ////////////////////////////////////////////////////////////
 #include "../include/Button.hpp"
+#include "../include/ButtonRouter.hpp"
 
 ColorSet::ColorSet()
 {
@@ -66,6 +67,7 @@ void Button::setButtonColor(sf::Color color, sf::Color hover, sf::Color press)
     this->buttonColorSet.color = color;
     this->buttonColorSet.hover = hover;
     this->buttonColorSet.press = press;
+    refreshButtonState();
 }
 
 void Button::setLabelColor(sf::Color color)
@@ -79,10 +81,66 @@ void Button::setLabelColor(sf::Color color, sf::Color hover, sf::Color press)
     this->labelColorSet.color = color;
     this->labelColorSet.hover = hover;
     this->labelColorSet.press = press;
+    refreshButtonState();
 }
 
 void Button::setButtonEnabled(bool enabled)
 {
+    if (this->enabled != enabled && router)
+    {
+        router->invalidate();
+    }
+    if (this->enabled != enabled)
+    {
+        visualVersion++;
+    }
     this->enabled = enabled;
 }
+
+void Button::setButtonState(bool hover, bool held)
+{
+    this->isHover = hover;
+    if (stateValid && hover == stateHover && held == stateHeld && isActive == stateActive)
+    {
+        return;
+    }
+    stateValid = true;
+    stateHover = hover;
+    stateHeld = held;
+    stateActive = isActive;
+    visualVersion++;
+
+    sf::Shape& shape = getButtonShape();
+
+    if (!isActive)
+    {
+        shape.setFillColor(disabled);
+    }
+    else if (held)
+    {
+        shape.setFillColor(buttonColorSet.press);
+        buttonLabel.setFillColor(labelColorSet.press);
+    }
+    else if (hover)
+    {
+        shape.setFillColor(buttonColorSet.hover);
+        buttonLabel.setFillColor(labelColorSet.hover);
+    }
+    else
+    {
+        shape.setFillColor(buttonColorSet.color);
+        buttonLabel.setFillColor(labelColorSet.color);
+    }
+}
+
+void Button::refreshButtonState()
+{
+    stateValid = false;
+    setButtonState(stateHover, stateHeld);
+}
+
+bool Button::isButtonEnabled() const
+{
+    return enabled;
+}
 unsigned int Button::count = 0;
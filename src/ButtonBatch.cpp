@@ -0,0 +1,182 @@
+#include "../include/ButtonBatch.hpp"
+
+////////////////////////////////////////////////////////////
+///
+/// @category ButtonBatch methods
+///
+////////////////////////////////////////////////////////////
+
+ButtonBatch::ButtonBatch()
+    : structureChanged(true), font(nullptr), shapes(sf::Triangles)
+{
+}
+
+////////////////////////////////////////////////////////////
+
+void ButtonBatch::add(Button& button)
+{
+    buttons.push_back(&button);
+    versions.push_back(button.getVisualVersion());
+    structureChanged = true;
+}
+
+////////////////////////////////////////////////////////////
+
+void ButtonBatch::update()
+{
+    bool changed = structureChanged;
+    for (std::size_t i = 0; i < buttons.size(); ++i)
+    {
+        if (versions[i] != buttons[i]->getVisualVersion())
+        {
+            versions[i] = buttons[i]->getVisualVersion();
+            changed = true;
+        }
+    }
+    if (!changed)
+    {
+        return;
+    }
+    structureChanged = false;
+
+    shapes.clear();
+    for (GlyphBatch& batch : glyphs)
+    {
+        batch.vertices.clear();
+    }
+    for (Button* button : buttons)
+    {
+        if (!button->isButtonDrawn())
+        {
+            continue;
+        }
+        appendShape(button->getButtonShape());
+        if (button->isLabelVisible)
+        {
+            appendLabel(button->getButtonLabel());
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////
+
+unsigned int ButtonBatch::getDrawCalls() const
+{
+    unsigned int calls = shapes.getVertexCount() > 0 ? 1 : 0;
+    for (const GlyphBatch& batch : glyphs)
+    {
+        calls += batch.vertices.getVertexCount() > 0 ? 1 : 0;
+    }
+    return calls;
+}
+
+////////////////////////////////////////////////////////////
+
+void ButtonBatch::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+    if (shapes.getVertexCount() > 0)
+    {
+        target.draw(shapes, states);
+    }
+    for (const GlyphBatch& batch : glyphs)
+    {
+        if (batch.vertices.getVertexCount() > 0)
+        {
+            states.texture = &font->getTexture(batch.charSize);
+            target.draw(batch.vertices, states);
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////
+
+void ButtonBatch::appendShape(sf::Shape& shape)
+{
+    // Triangle fan around the first point, in world coordinates
+    const std::size_t count = shape.getPointCount();
+    if (count < 3)
+    {
+        return;
+    }
+    const sf::Transform& transform = shape.getTransform();
+    const sf::Color color = shape.getFillColor();
+    const sf::Vector2f first = transform.transformPoint(shape.getPoint(0));
+    sf::Vector2f previous = transform.transformPoint(shape.getPoint(1));
+    for (std::size_t i = 2; i < count; ++i)
+    {
+        const sf::Vector2f point = transform.transformPoint(shape.getPoint(i));
+        shapes.append(sf::Vertex(first, color));
+        shapes.append(sf::Vertex(previous, color));
+        shapes.append(sf::Vertex(point, color));
+        previous = point;
+    }
+}
+
+////////////////////////////////////////////////////////////
+
+void ButtonBatch::appendLabel(const sf::Text& text)
+{
+    if (!text.getFont())
+    {
+        return;
+    }
+    font = text.getFont();
+
+    const unsigned int charSize = text.getCharacterSize();
+    GlyphBatch* batch = nullptr;
+    for (GlyphBatch& candidate : glyphs)
+    {
+        if (candidate.charSize == charSize)
+        {
+            batch = &candidate;
+        }
+    }
+    if (!batch)
+    {
+        glyphs.push_back(GlyphBatch());
+        batch = &glyphs.back();
+        batch->charSize = charSize;
+        batch->vertices.setPrimitiveType(sf::Triangles);
+    }
+
+    // Same layout as sf::Text: baseline at charSize, kerning between pairs
+    const std::string str = text.getString().toAnsiString();
+    const sf::Transform& transform = text.getTransform();
+    const sf::Color color = text.getFillColor();
+    float x = 0.f;
+    const float baseline = static_cast<float>(charSize);
+    sf::Uint32 previous = 0;
+    for (char c : str)
+    {
+        const sf::Uint32 current = static_cast<unsigned char>(c);
+        x += font->getKerning(previous, current, charSize);
+        previous = current;
+
+        const sf::Glyph& glyph = font->getGlyph(current, charSize, false);
+        if (c != ' ' && c != '\t')
+        {
+            const float left = x + glyph.bounds.left;
+            const float top = baseline + glyph.bounds.top;
+            const float right = left + glyph.bounds.width;
+            const float bottom = top + glyph.bounds.height;
+
+            const float u1 = static_cast<float>(glyph.textureRect.left);
+            const float v1 = static_cast<float>(glyph.textureRect.top);
+            const float u2 = u1 + glyph.textureRect.width;
+            const float v2 = v1 + glyph.textureRect.height;
+
+            const sf::Vector2f topLeft = transform.transformPoint(sf::Vector2f(left, top));
+            const sf::Vector2f topRight = transform.transformPoint(sf::Vector2f(right, top));
+            const sf::Vector2f bottomLeft = transform.transformPoint(sf::Vector2f(left, bottom));
+            const sf::Vector2f bottomRight = transform.transformPoint(sf::Vector2f(right, bottom));
+
+            batch->vertices.append(sf::Vertex(topLeft, color, sf::Vector2f(u1, v1)));
+            batch->vertices.append(sf::Vertex(topRight, color, sf::Vector2f(u2, v1)));
+            batch->vertices.append(sf::Vertex(bottomLeft, color, sf::Vector2f(u1, v2)));
+            batch->vertices.append(sf::Vertex(bottomLeft, color, sf::Vector2f(u1, v2)));
+            batch->vertices.append(sf::Vertex(topRight, color, sf::Vector2f(u2, v1)));
+            batch->vertices.append(sf::Vertex(bottomRight, color, sf::Vector2f(u2, v2)));
+        }
+        x += glyph.advance;
+    }
+}
@@ -0,0 +1,236 @@
+#include "../include/ButtonRouter.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+////////////////////////////////////////////////////////////
+///
+/// @category ButtonRouter methods
+///
+////////////////////////////////////////////////////////////
+
+ButtonRouter::ButtonRouter(float cellSize)
+    : cellSize(cellSize), cols(0), rows(0), indexDirty(true), mouseInside(false),
+      hovered(nullptr), held(nullptr), clicked(nullptr)
+{
+}
+
+////////////////////////////////////////////////////////////
+
+ButtonRouter::~ButtonRouter()
+{
+    for (Button* button : buttons)
+    {
+        button->router = nullptr;
+    }
+}
+
+////////////////////////////////////////////////////////////
+
+void ButtonRouter::add(Button& button)
+{
+    button.router = this;
+    buttons.push_back(&button);
+    button.setButtonState(false, false);
+    indexDirty = true;
+}
+
+////////////////////////////////////////////////////////////
+
+Button* ButtonRouter::dispatch(sf::RenderWindow& window, const sf::Event& event)
+{
+    // isPressed only lasts for the event that caused it
+    if (clicked)
+    {
+        clicked->isPressed = false;
+        clicked = nullptr;
+    }
+
+    if (indexDirty)
+    {
+        rebuild();
+        held = nullptr;
+        setHover(mouseInside ? hitTest(mousePos) : nullptr);
+    }
+
+    switch (event.type)
+    {
+        case sf::Event::MouseMoved:
+            mousePos = window.mapPixelToCoords(sf::Vector2i(event.mouseMove.x, event.mouseMove.y));
+            mouseInside = true;
+            setHover(hitTest(mousePos));
+            break;
+
+        case sf::Event::MouseButtonPressed:
+            mousePos = window.mapPixelToCoords(sf::Vector2i(event.mouseButton.x, event.mouseButton.y));
+            mouseInside = true;
+            setHover(hitTest(mousePos));
+            if (hovered)
+            {
+                held = hovered;
+                held->setButtonState(true, true);
+            }
+            break;
+
+        case sf::Event::MouseButtonReleased:
+            mousePos = window.mapPixelToCoords(sf::Vector2i(event.mouseButton.x, event.mouseButton.y));
+            mouseInside = true;
+            if (held)
+            {
+                Button* wasHeld = held;
+                held = nullptr;
+                wasHeld->setButtonState(wasHeld == hovered, false);
+            }
+            setHover(hitTest(mousePos));
+            if (hovered)
+            {
+                clicked = hovered;
+                clicked->isPressed = true;
+            }
+            break;
+
+        case sf::Event::MouseLeft:
+            mouseInside = false;
+            setHover(nullptr);
+            break;
+
+        default:
+            break;
+    }
+
+    return clicked;
+}
+
+////////////////////////////////////////////////////////////
+
+void ButtonRouter::rebuild()
+{
+    indexDirty = false;
+    cellStart.clear();
+    cellEntries.clear();
+    cols = rows = 0;
+
+    // Only enabled, active buttons can be hit; the rest get their idle colours
+    std::vector<Button*> live;
+    sf::FloatRect area;
+    for (Button* button : buttons)
+    {
+        button->setButtonState(false, false);
+        if (!button->enabled || !button->isActive)
+        {
+            continue;
+        }
+        const sf::FloatRect bounds = button->getButtonShape().getGlobalBounds();
+        if (live.empty())
+        {
+            area = bounds;
+        }
+        else
+        {
+            const float right = std::max(area.left + area.width, bounds.left + bounds.width);
+            const float bottom = std::max(area.top + area.height, bounds.top + bounds.height);
+            area.left = std::min(area.left, bounds.left);
+            area.top = std::min(area.top, bounds.top);
+            area.width = right - area.left;
+            area.height = bottom - area.top;
+        }
+        live.push_back(button);
+    }
+    hovered = nullptr;
+    if (live.empty())
+    {
+        return;
+    }
+
+    origin = sf::Vector2f(area.left, area.top);
+    cols = static_cast<unsigned int>(std::floor(area.width / cellSize)) + 1;
+    rows = static_cast<unsigned int>(std::floor(area.height / cellSize)) + 1;
+
+    // Counting sort of (cell, button) pairs into a flat array
+    cellStart.assign(cols * rows + 1, 0);
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        if (pass == 1)
+        {
+            for (std::size_t c = 1; c < cellStart.size(); ++c)
+            {
+                cellStart[c] += cellStart[c - 1];
+            }
+            cellEntries.resize(cellStart.back());
+        }
+        std::vector<unsigned int> fill(cellStart.begin(), cellStart.end() - 1);
+        for (Button* button : live)
+        {
+            const sf::FloatRect bounds = button->getButtonShape().getGlobalBounds();
+            const unsigned int x0 = static_cast<unsigned int>((bounds.left - origin.x) / cellSize);
+            const unsigned int y0 = static_cast<unsigned int>((bounds.top - origin.y) / cellSize);
+            const unsigned int x1 = std::min(cols - 1, static_cast<unsigned int>((bounds.left + bounds.width - origin.x) / cellSize));
+            const unsigned int y1 = std::min(rows - 1, static_cast<unsigned int>((bounds.top + bounds.height - origin.y) / cellSize));
+            for (unsigned int y = y0; y <= y1; ++y)
+            {
+                for (unsigned int x = x0; x <= x1; ++x)
+                {
+                    if (pass == 0)
+                    {
+                        cellStart[y * cols + x + 1]++;
+                    }
+                    else
+                    {
+                        cellEntries[fill[y * cols + x]++] = button;
+                    }
+                }
+            }
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////
+
+Button* ButtonRouter::hitTest(sf::Vector2f point) const
+{
+    if (cols == 0 || point.x < origin.x || point.y < origin.y)
+    {
+        return nullptr;
+    }
+    const unsigned int x = static_cast<unsigned int>((point.x - origin.x) / cellSize);
+    const unsigned int y = static_cast<unsigned int>((point.y - origin.y) / cellSize);
+    if (x >= cols || y >= rows)
+    {
+        return nullptr;
+    }
+
+    // Later buttons are drawn on top, so the last match wins
+    const unsigned int cell = y * cols + x;
+    for (unsigned int i = cellStart[cell + 1]; i > cellStart[cell]; --i)
+    {
+        Button* button = cellEntries[i - 1];
+        if (button->getButtonShape().getGlobalBounds().contains(point))
+        {
+            return button;
+        }
+    }
+    return nullptr;
+}
+
+////////////////////////////////////////////////////////////
+
+void ButtonRouter::setHover(Button* button)
+{
+    if (button == hovered)
+    {
+        return;
+    }
+    if (hovered)
+    {
+        hovered->setButtonState(false, false);
+    }
+    if (held && held != button)
+    {
+        held = nullptr;
+    }
+    hovered = button;
+    if (hovered)
+    {
+        hovered->setButtonState(true, hovered == held);
+    }
+}
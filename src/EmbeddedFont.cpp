@@ -0,0 +1,20 @@
+#include "../include/EmbeddedFont.hpp"
+
+// Generado por compilar.sh: unsigned char Arial_ttf[] y unsigned int Arial_ttf_len
+#include "Arial_ttf.h"
+
+const char UiCharacters[] =
+    " 0123456789+-*/:.,()[]%"
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+    "abcdefghijklmnopqrstuvwxyz";
+
+bool loadEmbeddedFont(sf::Font &font) {
+    // sf::Font lee de este arreglo mientras viva, y el arreglo vive siempre
+    return font.loadFromMemory(Arial_ttf, Arial_ttf_len);
+}
+
+void prerasterize(const sf::Font &font, const std::string &text, unsigned int charSize) {
+    for (char c : text) {
+        font.getGlyph(static_cast<unsigned char>(c), charSize, false);
+    }
+}
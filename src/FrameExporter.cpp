@@ -0,0 +1,172 @@
+#include "../include/FrameExporter.hpp"
+
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+////////////////////////////////////////////////////////////
+///
+/// @category FrameExporter methods
+///
+////////////////////////////////////////////////////////////
+
+FrameExporter::FrameExporter()
+    : format(PngSequence), width(0), height(0), fd(-1), capacity(0), closing(false), failed(false), frameCount(0)
+{
+}
+
+////////////////////////////////////////////////////////////
+
+FrameExporter::~FrameExporter()
+{
+    close();
+}
+
+////////////////////////////////////////////////////////////
+
+bool FrameExporter::open(const std::string& path, Format format, unsigned int width, unsigned int height, unsigned int threads)
+{
+    close();
+
+    if (format == RawStream)
+    {
+        fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0)
+        {
+            return false;
+        }
+    }
+    else if (::mkdir(path.c_str(), 0755) != 0)
+    {
+        struct stat info;
+        if (::stat(path.c_str(), &info) != 0 || !S_ISDIR(info.st_mode))
+        {
+            return false;
+        }
+    }
+
+    if (threads == 0)
+    {
+        threads = std::thread::hardware_concurrency();
+    }
+    if (threads == 0)
+    {
+        threads = 1;
+    }
+
+    this->path = path;
+    this->format = format;
+    this->width = width;
+    this->height = height;
+    capacity = threads * 2;
+    closing = false;
+    failed = false;
+    frameCount = 0;
+
+    workers.reserve(threads);
+    for (unsigned int i = 0; i < threads; ++i)
+    {
+        workers.push_back(std::thread(&FrameExporter::work, this));
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////
+
+void FrameExporter::push(const sf::Texture& texture)
+{
+    // The readback has to happen on the thread that owns the GL context
+    Frame frame;
+    frame.index = frameCount++;
+    frame.image.reset(new sf::Image(texture.copyToImage()));
+
+    std::unique_lock<std::mutex> lock(mutex);
+    notFull.wait(lock, [this]() { return queue.size() < capacity; });
+    queue.push_back(std::move(frame));
+    lock.unlock();
+    notEmpty.notify_one();
+}
+
+////////////////////////////////////////////////////////////
+
+bool FrameExporter::close()
+{
+    if (workers.empty())
+    {
+        return !failed;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        closing = true;
+    }
+    notEmpty.notify_all();
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+    workers.clear();
+
+    if (fd >= 0)
+    {
+        if (::close(fd) != 0)
+        {
+            failed = true;
+        }
+        fd = -1;
+    }
+    return !failed;
+}
+
+////////////////////////////////////////////////////////////
+
+void FrameExporter::work()
+{
+    for (;;)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        notEmpty.wait(lock, [this]() { return closing || !queue.empty(); });
+        if (queue.empty())
+        {
+            return;
+        }
+        Frame frame = std::move(queue.front());
+        queue.pop_front();
+        lock.unlock();
+        notFull.notify_one();
+
+        if (!encode(frame))
+        {
+            std::lock_guard<std::mutex> failLock(mutex);
+            failed = true;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////
+
+bool FrameExporter::encode(const Frame& frame)
+{
+    if (format == PngSequence)
+    {
+        char name[32];
+        std::snprintf(name, sizeof(name), "/frame_%06llu.png", static_cast<unsigned long long>(frame.index));
+        return frame.image->saveToFile(path + name);
+    }
+
+    const std::size_t frameSize = static_cast<std::size_t>(width) * height * 4;
+    const char* pixels = reinterpret_cast<const char*>(frame.image->getPixelsPtr());
+    off_t offset = static_cast<off_t>(frame.index * frameSize);
+    std::size_t done = 0;
+    while (done < frameSize)
+    {
+        const ssize_t written = ::pwrite(fd, pixels + done, frameSize - done, offset + done);
+        if (written <= 0)
+        {
+            return false;
+        }
+        done += written;
+    }
+    return true;
+}
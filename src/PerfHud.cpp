@@ -0,0 +1,159 @@
+#include "../include/PerfHud.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+////////////////////////////////////////////////////////////
+///
+/// @category PerfHud methods
+///
+////////////////////////////////////////////////////////////
+
+namespace
+{
+    const char* const PhaseNames[PerfHud::PhaseCount] = { "eventos", "update", "draw", "display" };
+
+    // Text refresh period, so the overlay stays readable and cheap
+    const float TextPeriod = 0.25f;
+}
+
+////////////////////////////////////////////////////////////
+
+PerfHud::PerfHud(const sf::Font& font, unsigned int charSize)
+    : samples(Capacity), next(0), count(0), totalFrames(0), current(), visible(false), text("", font, charSize)
+{
+    background.setFillColor(sf::Color(0, 0, 0, 180));
+    background.setPosition(5, 5);
+    text.setPosition(10, 8);
+    text.setFillColor(sf::Color::White);
+}
+
+////////////////////////////////////////////////////////////
+
+void PerfHud::beginFrame()
+{
+    current = Sample();
+    frameStart = clock.getElapsedTime();
+    lastMark = frameStart;
+}
+
+////////////////////////////////////////////////////////////
+
+void PerfHud::mark(Phase phase)
+{
+    const sf::Time now = clock.getElapsedTime();
+    current.phase[phase] += (now - lastMark).asMicroseconds() / 1000.f;
+    lastMark = now;
+}
+
+////////////////////////////////////////////////////////////
+
+void PerfHud::endFrame(unsigned int drawCalls, unsigned int moves)
+{
+    current.frame = (clock.getElapsedTime() - frameStart).asMicroseconds() / 1000.f;
+    current.drawCalls = drawCalls;
+    current.moves = moves;
+
+    samples[next] = current;
+    next = (next + 1) % Capacity;
+    if (count < Capacity)
+    {
+        count++;
+    }
+    totalFrames++;
+}
+
+////////////////////////////////////////////////////////////
+
+const PerfHud::Sample& PerfHud::at(std::size_t age) const
+{
+    // age 0 is the oldest sample still in the buffer
+    return samples[(next + Capacity - count + age) % Capacity];
+}
+
+////////////////////////////////////////////////////////////
+
+void PerfHud::draw(sf::RenderTarget& target)
+{
+    if (!visible)
+    {
+        return;
+    }
+    if (textClock.getElapsedTime().asSeconds() >= TextPeriod || text.getString().getSize() == 0)
+    {
+        textClock.restart();
+        rebuildText();
+    }
+    target.draw(background);
+    target.draw(text);
+}
+
+////////////////////////////////////////////////////////////
+
+void PerfHud::rebuildText()
+{
+    if (count == 0)
+    {
+        text.setString("Sin muestras");
+        return;
+    }
+
+    std::vector<float> frames(count);
+    float phaseSum[PhaseCount] = {};
+    double totalTime = 0;
+    std::uint64_t totalMoves = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const Sample& sample = at(i);
+        frames[i] = sample.frame;
+        for (int p = 0; p < PhaseCount; ++p)
+        {
+            phaseSum[p] += sample.phase[p];
+        }
+        totalTime += sample.frame;
+        totalMoves += sample.moves;
+    }
+    std::sort(frames.begin(), frames.end());
+    const float p50 = frames[count / 2];
+    const float p95 = frames[count * 95 / 100];
+    const float p99 = frames[count * 99 / 100];
+
+    char line[128];
+    std::string str;
+    std::snprintf(line, sizeof(line), "frame ms  p50 %.2f  p95 %.2f  p99 %.2f  max %.2f\n", p50, p95, p99, frames[count - 1]);
+    str += line;
+    for (int p = 0; p < PhaseCount; ++p)
+    {
+        std::snprintf(line, sizeof(line), "  %-8s %.3f ms\n", PhaseNames[p], phaseSum[p] / count);
+        str += line;
+    }
+    std::snprintf(line, sizeof(line), "draw calls %u  mov/s %.0f  (%u muestras)", at(count - 1).drawCalls,
+                  totalTime > 0 ? totalMoves * 1000.0 / totalTime : 0.0, static_cast<unsigned int>(count));
+    str += line;
+
+    text.setString(str);
+    const sf::FloatRect bounds = text.getLocalBounds();
+    background.setSize(sf::Vector2f(bounds.width + 12, bounds.height + 14));
+}
+
+////////////////////////////////////////////////////////////
+
+bool PerfHud::dumpCsv(const std::string& path) const
+{
+    std::FILE* file = std::fopen(path.c_str(), "w");
+    if (!file)
+    {
+        return false;
+    }
+
+    std::fprintf(file, "frame,events_ms,update_ms,draw_ms,display_ms,frame_ms,draw_calls,moves\n");
+    const std::uint64_t first = totalFrames - count;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const Sample& sample = at(i);
+        std::fprintf(file, "%llu,%.4f,%.4f,%.4f,%.4f,%.4f,%u,%u\n", static_cast<unsigned long long>(first + i),
+                     sample.phase[EventsPhase], sample.phase[UpdatePhase], sample.phase[DrawPhase], sample.phase[DisplayPhase],
+                     sample.frame, sample.drawCalls, sample.moves);
+    }
+    return std::fclose(file) == 0;
+}
@@ -68,62 +68,22 @@ void RectButton::getButtonStatus(sf::RenderWindow& window, sf::Event& event)
     this->mousePosWindow = sf::Mouse::getPosition(window);
     this->mousePosView = window.mapPixelToCoords(this->mousePosWindow);
 
-    this->isHover = false;
     this->isPressed = false;
 
-    if (isActive)
+    // Colours are only touched when hover, held or active actually change
+    const bool inside = isActive && button.getGlobalBounds().contains(this->mousePosView);
+    if (inside && event.type == sf::Event::MouseButtonReleased && enabled)
     {
-        button.setFillColor(buttonColorSet.color);
-        buttonLabel.setFillColor(labelColorSet.color);
-        if(button.getGlobalBounds().contains(this->mousePosView))
-        {
-            this->isHover = true;
-        }
-
-        if(button.getGlobalBounds().contains(this->mousePosView))
-        {
-            if(event.type == sf::Event::MouseButtonReleased)
-            {
-                if (!enabled) {
-                    return;
-                }
-                this->isPressed = true;
-            }
-        }
-
-        //I am not sure if it is best to implement this inside a class
-        if (isHover)
-        {
-            button.setFillColor(buttonColorSet.hover);
-            buttonLabel.setFillColor(labelColorSet.hover);
-        }
-        else
-        {
-            button.setFillColor(buttonColorSet.color);
-        }
-
-        if(button.getGlobalBounds().contains(this->mousePosView))
-        {
-            if (event.type == sf::Event::MouseButtonPressed)
-            {
-                button.setFillColor(buttonColorSet.press);
-                buttonLabel.setFillColor(labelColorSet.press);
-            }
-        }
-
-    }
-    else
-    {
-        button.setFillColor(disabled);
+        this->isPressed = true;
     }
-
+    setButtonState(inside, inside && event.type == sf::Event::MouseButtonPressed);
 }
 
 ////////////////////////////////////////////////////////////
 
 void RectButton::draw(sf::RenderWindow& window)
 {
-    if (!enabled) {
+    if (!isButtonDrawn()) {
         return;
     }
 
@@ -168,6 +128,10 @@ void RectButton::setButtonLabel(float charSize, std::string label)
         this->buttonLabel.setPosition(this->buttonPos.x+(this->buttonRect.width/2.0f),
                                       this->buttonPos.y+(this->buttonRect.height/5.0f));
     }
+
+    // The label colour was reset, so the state colours must be applied again
+    stateValid = false;
+    visualVersion++;
 }
 
 ////////////////////////////////////////////////////////////
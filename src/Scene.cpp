@@ -0,0 +1,95 @@
+#include "../include/Scene.hpp"
+#include <algorithm>
+
+sf::Color inverseLegibleColor(sf::Color color) {
+    int r = color.r;
+    int g = color.g;
+    int b = color.b;
+    if (r * 0.299 + g * 0.7 + b * 0.114 > 150) {
+        return sf::Color::Black;
+    } else {
+        return sf::Color::White;
+    }
+}
+
+float linearInterpolation(float a, float b, float t) {
+    return a + (b - a) * t;
+}
+
+float getTowerHeight(int numDisks, float windowHeight) {
+    float minHeight = windowHeight / 6;
+    float maxHeight = windowHeight * 0.8f;
+    float factor = (maxHeight - minHeight) / 15;
+    return clamp(minHeight + numDisks * factor, minHeight, maxHeight);
+}
+
+float getDiskHeight(int numDisks, float towerHeight) {
+    const float maxHeight = 30.f;
+    return numDisks > 0 ? std::min(maxHeight, (towerHeight - 10.f) / numDisks) : maxHeight;
+}
+
+void animateDiskMove(Disk &disk, const sf::Vector2f init, const sf::Vector2f goal, const float towerMax, const float delta) {
+    // the function will only use the delta to determine the position of the disk
+    // the delta is te range from 0-1 that describes the completion of the animation
+    float x, y;
+    if (delta < (3/8.f)) {
+        x = init.x;
+        y = linearInterpolation(init.y, towerMax, delta / (3/8.f));
+    } else if (delta < (5/8.f)) {
+        x = linearInterpolation(init.x, goal.x, (delta - 3/8.f) / (5/8.f - 3/8.f));
+        y = towerMax;
+    } else {
+        x = goal.x;
+        y = linearInterpolation(towerMax, goal.y, (delta - 5/8.f) / (1 - 5/8.f));
+    }
+    
+    disk.setPosition(x, y);
+}
+
+void calculateTowersPos(std::vector<Tower*> &towers, const float windowWidth, const float windowHeight, float towerHeight, sf::RectangleShape &base, std::vector<sf::Text*> &labels) {
+    const int numTowers = towers.size();
+    for (int i = 0; i < numTowers; ++i) {
+        // Las torres de los extremos se separan 15 px hacia afuera
+        const float offset = numTowers > 1 ? 15.f * (2 * i - (numTowers - 1)) / (numTowers - 1) : 0.f;
+        towers[i]->setPosition((i + 1) * windowWidth / (numTowers + 1) + offset, windowHeight - (windowHeight - towerHeight) / 2);
+        if (i < (int)labels.size()) {
+            labels[i]->setPosition(towers[i]->getPosition().x - 5, towers[i]->getPosition().y + 4);
+        }
+    }
+    base.setPosition(50, towerHeight + (windowHeight - towerHeight) / 2);
+}
+
+void drawTowers(sf::RenderTarget &target, std::vector<Tower*> &towers, sf::RectangleShape &base, std::vector<sf::Text*> &labels, const float towerWidth, const float towerHeight, sf::Font &font) {
+    // - Base
+    target.draw(base);
+    for (sf::Text* label : labels) {
+        target.draw(*label);
+    }
+
+    // - Torres
+    for (Tower* tower : towers) {
+        // Palo
+        sf::RectangleShape palo;
+        palo.setSize(sf::Vector2f(towerWidth, towerHeight));
+        palo.setFillColor(sf::Color::White);
+        palo.setPosition(tower->getPosition().x - towerWidth / 2, tower->getPosition().y - towerHeight);
+        target.draw(palo);
+    }
+    for (Tower* tower : towers) {
+        // Discos
+        for (std::uint64_t mask = tower->getDiskMask(); mask != 0; mask &= mask - 1) {
+            Disk& disk = tower->getDisk(__builtin_ctzll(mask));
+            sf::RectangleShape shape(disk.getSize());
+            shape.setPosition(disk.getPosition());
+            shape.setFillColor(disk.getColor());
+            target.draw(shape);
+            sf::Text diskNum(std::to_string(disk.getNum()), font, 14);
+            diskNum.setPosition(
+                disk.getPosition().x + disk.getSize().x / 2 - 7,
+                disk.getPosition().y + disk.getSize().y / 2 - 7
+            );
+            diskNum.setFillColor(inverseLegibleColor(disk.getColor()));
+            target.draw(diskNum);
+        }
+    }
+}
@@ -0,0 +1,38 @@
+#include "../include/SceneLayout.hpp"
+#include "../include/Scene.hpp"
+
+SceneLayout computeLayout(int numDisks, int numPegs, float width, float height) {
+    SceneLayout layout;
+    const float spacing = width / (numPegs + 1);
+    layout.towerHeight = getTowerHeight(numDisks, height);
+    layout.towerWidth = clamp(spacing / 11, 4.f, 20.f);
+    layout.diskHeight = getDiskHeight(numDisks, layout.towerHeight);
+    // El mas grande ocupa el espacio entre torres y el mas chico queda unos
+    // 30 px mas ancho que cero
+    const float minWidth = 10.f;
+    layout.maxDiskWidth = spacing;
+    layout.diskWidthStep = numDisks > 0 ? ((spacing - 20) - minWidth) / numDisks : 0.f;
+    return layout;
+}
+
+void DiskGeometry::resize(std::size_t count) {
+    x.assign(count, 0.f);
+    y.assign(count, 0.f);
+    width.assign(count, 0.f);
+    color.assign(count, sf::Color::White);
+    dirty.assign(count, 1);
+}
+
+void DiskGeometry::applyLayout(const SceneLayout &layout) {
+    // El disco i se muestra con el numero size - 1 - i (0 = el mas grande)
+    const std::size_t count = size();
+    for (std::size_t i = 0; i < count; ++i) {
+        width[i] = layout.maxDiskWidth - (count - 1 - i) * layout.diskWidthStep;
+    }
+    height = layout.diskHeight;
+    markAllDirty();
+}
+
+void DiskGeometry::markAllDirty() {
+    dirty.assign(dirty.size(), 1);
+}
@@ -0,0 +1,314 @@
+#include "../include/SceneRenderer.hpp"
+#include "../include/Scene.hpp"
+
+namespace
+{
+    // Below this disk height a disk is thinner than a pixel row or two and
+    // the pegs are drawn as bands instead
+    const float MinDiskHeight = 2.f;
+
+    // Smallest band, in pixels
+    const float BandHeight = 3.f;
+}
+
+////////////////////////////////////////////////////////////
+///
+/// @category SceneRenderer methods
+///
+////////////////////////////////////////////////////////////
+
+SceneRenderer::SceneRenderer(sf::Font& font, unsigned int charSize)
+    : font(font), charSize(charSize), shapes(sf::Triangles), glyphs(sf::Triangles),
+      glyphCache(128), glyphCached(128, false), numDisks(0), staticQuads(0), updatedDisks(0),
+      diskHeight(0), banded(false)
+{
+    // Rasterize the labels up front so the atlas does not grow mid-animation
+    for (char c = '0'; c <= '9'; ++c)
+    {
+        getGlyph(c);
+    }
+    for (char c = 'A'; c <= 'Z'; ++c)
+    {
+        getGlyph(c);
+    }
+}
+
+////////////////////////////////////////////////////////////
+
+void SceneRenderer::update(std::vector<Tower*>& towers, DiskGeometry& geometry, const sf::RectangleShape& base, std::vector<sf::Text*>& labels, float towerWidth, float towerHeight)
+{
+    // Shapes:  [base][pegs][disk 0]...[disk n-1], 6 vertices per quad
+    // Glyphs:  [disk 0 digits]...[disk n-1 digits][labels]
+    // In band mode the disk slots hold the bands, packed from the first one
+    if (geometry.size() != numDisks || towers.size() + 1 != staticQuads || geometry.height != diskHeight)
+    {
+        numDisks = geometry.size();
+        staticQuads = towers.size() + 1;
+        diskHeight = geometry.height;
+        banded = numDisks > 0 && diskHeight < MinDiskHeight;
+        shapes.resize((staticQuads + numDisks) * 6);
+        staticKey.clear();
+        geometry.markAllDirty();
+    }
+
+    updateStatic(towers, base, labels, towerWidth, towerHeight);
+
+    updatedDisks = 0;
+    if (banded)
+    {
+        bool dirty = false;
+        for (std::size_t i = 0; i < numDisks; ++i)
+        {
+            dirty |= geometry.dirty[i] != 0;
+            geometry.dirty[i] = 0;
+        }
+        if (dirty)
+        {
+            updateBands(towers, geometry);
+        }
+        return;
+    }
+
+    for (std::size_t i = 0; i < numDisks; ++i)
+    {
+        if (geometry.dirty[i])
+        {
+            updateDisk(geometry, i);
+            geometry.dirty[i] = 0;
+            updatedDisks++;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////
+
+void SceneRenderer::updateStatic(std::vector<Tower*>& towers, const sf::RectangleShape& base, std::vector<sf::Text*>& labels, float towerWidth, float towerHeight)
+{
+    // Built in a member buffer that keeps its capacity, so the check allocates nothing
+    std::vector<float>& key = scratchKey;
+    key.clear();
+    key.push_back(base.getPosition().x);
+    key.push_back(base.getPosition().y);
+    key.push_back(base.getSize().x);
+    key.push_back(towerWidth);
+    key.push_back(towerHeight);
+    for (Tower* tower : towers)
+    {
+        key.push_back(tower->getPosition().x);
+        key.push_back(tower->getPosition().y);
+    }
+    for (sf::Text* label : labels)
+    {
+        key.push_back(label->getPosition().x);
+        key.push_back(label->getPosition().y);
+    }
+    if (key == staticKey)
+    {
+        return;
+    }
+    staticKey.swap(key);
+
+    // - Base y palos
+    setQuad(shapes, 0, base.getPosition(), base.getSize(), base.getFillColor());
+    for (std::size_t i = 0; i < towers.size(); ++i)
+    {
+        setQuad(shapes, (i + 1) * 6,
+                sf::Vector2f(towers[i]->getPosition().x - towerWidth / 2, towers[i]->getPosition().y - towerHeight),
+                sf::Vector2f(towerWidth, towerHeight), sf::Color::White);
+    }
+
+    // - Etiquetas, despues de los digitos de los discos
+    std::size_t labelChars = 0;
+    for (sf::Text* label : labels)
+    {
+        labelChars += label->getString().toAnsiString().size();
+    }
+    std::size_t first = numDisks * DiskDigits * 6;
+    glyphs.resize(first + labelChars * 6);
+    for (sf::Text* label : labels)
+    {
+        const std::string text = label->getString().toAnsiString();
+        setText(first, text.size(), text, label->getPosition(), label->getFillColor());
+        first += text.size() * 6;
+    }
+}
+
+////////////////////////////////////////////////////////////
+
+void SceneRenderer::updateDisk(const DiskGeometry& geometry, std::size_t index)
+{
+    // One instance: the unit quad scaled to the disk's width and height and
+    // moved to its position, taking its colour
+    const sf::Vector2f position(geometry.x[index], geometry.y[index]);
+    const sf::Vector2f size(geometry.width[index], geometry.height);
+    const sf::Color color = geometry.color[index];
+    setQuad(shapes, (staticQuads + index) * 6, position, size, color);
+
+    // The number does not fit on thin disks
+    const std::size_t number = numDisks - 1 - index;
+    setText(index * DiskDigits * 6, DiskDigits, size.y < charSize ? std::string() : std::to_string(number),
+            sf::Vector2f(position.x + size.x / 2 - 7, position.y + size.y / 2 - 7),
+            inverseLegibleColor(color));
+}
+
+////////////////////////////////////////////////////////////
+
+void SceneRenderer::updateBands(std::vector<Tower*>& towers, const DiskGeometry& geometry)
+{
+    std::size_t band = 0;
+    for (Tower* tower : towers)
+    {
+        if (tower->isEmpty())
+        {
+            continue;
+        }
+
+        // Runs of disks at least BandHeight tall become one trapezoid, shaded
+        // from the colour of its bottom disk to that of its top disk. The top
+        // disk of the peg is always drawn alone, so the disk in flight (still
+        // the top of its source peg) animates as usual.
+        const unsigned int top = tower->getTopDiskIndex();
+        const float x = tower->getPosition().x;
+        const unsigned int none = ~0u;
+        unsigned int first = none;
+        unsigned int last = none;
+        for (unsigned int index : tower->getDiskIndices())
+        {
+            if (index == top)
+            {
+                break;
+            }
+            last = index;
+            if (first == none)
+            {
+                first = index;
+            }
+            if (geometry.y[first] + geometry.height - geometry.y[last] >= BandHeight)
+            {
+                setBand(geometry, band++, x, first, last);
+                first = none;
+            }
+        }
+        if (first != none)
+        {
+            setBand(geometry, band++, x, first, last);
+        }
+
+        setQuad(shapes, (staticQuads + band++) * 6, sf::Vector2f(geometry.x[top], geometry.y[top]),
+                sf::Vector2f(geometry.width[top], geometry.height), geometry.color[top]);
+        updatedDisks++;
+    }
+
+    // Collapse the slots left over, and every digit
+    for (; band < numDisks; ++band)
+    {
+        for (std::size_t v = 0; v < 6; ++v)
+        {
+            shapes[(staticQuads + band) * 6 + v] = sf::Vertex(sf::Vector2f(0, 0), sf::Color::Transparent);
+        }
+    }
+    for (std::size_t i = 0; i < numDisks; ++i)
+    {
+        setText(i * DiskDigits * 6, DiskDigits, std::string(), sf::Vector2f(0, 0), sf::Color::Transparent);
+    }
+}
+
+////////////////////////////////////////////////////////////
+
+void SceneRenderer::setBand(const DiskGeometry& geometry, std::size_t band, float x, unsigned int bottom, unsigned int top)
+{
+    const float bottomY = geometry.y[bottom] + geometry.height;
+    const float topY = geometry.y[top];
+    const float bottomHalf = geometry.width[bottom] / 2;
+    const float topHalf = geometry.width[top] / 2;
+
+    sf::Vertex* quad = &shapes[(staticQuads + band) * 6];
+    quad[0] = sf::Vertex(sf::Vector2f(x - topHalf, topY), geometry.color[top]);
+    quad[1] = sf::Vertex(sf::Vector2f(x + topHalf, topY), geometry.color[top]);
+    quad[2] = sf::Vertex(sf::Vector2f(x - bottomHalf, bottomY), geometry.color[bottom]);
+    quad[3] = quad[2];
+    quad[4] = quad[1];
+    quad[5] = sf::Vertex(sf::Vector2f(x + bottomHalf, bottomY), geometry.color[bottom]);
+    updatedDisks++;
+}
+
+////////////////////////////////////////////////////////////
+
+void SceneRenderer::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+    target.draw(shapes, states);
+    states.texture = &font.getTexture(charSize);
+    target.draw(glyphs, states);
+}
+
+////////////////////////////////////////////////////////////
+
+void SceneRenderer::setQuad(sf::VertexArray& array, std::size_t first, sf::Vector2f position, sf::Vector2f size, sf::Color color)
+{
+    const sf::Vector2f topRight(position.x + size.x, position.y);
+    const sf::Vector2f bottomLeft(position.x, position.y + size.y);
+    const sf::Vector2f bottomRight(position.x + size.x, position.y + size.y);
+
+    array[first + 0] = sf::Vertex(position, color);
+    array[first + 1] = sf::Vertex(topRight, color);
+    array[first + 2] = sf::Vertex(bottomLeft, color);
+    array[first + 3] = sf::Vertex(bottomLeft, color);
+    array[first + 4] = sf::Vertex(topRight, color);
+    array[first + 5] = sf::Vertex(bottomRight, color);
+}
+
+////////////////////////////////////////////////////////////
+
+void SceneRenderer::setText(std::size_t first, std::size_t maxChars, const std::string& text, sf::Vector2f position, sf::Color color)
+{
+    // Same layout as sf::Text: the baseline sits charSize below the position
+    float x = position.x;
+    const float baseline = position.y + charSize;
+
+    for (std::size_t i = 0; i < maxChars; ++i)
+    {
+        sf::Vertex* quad = &glyphs[first + i * 6];
+        if (i >= text.size())
+        {
+            // Unused slot: collapse it so it rasterizes nothing
+            for (int v = 0; v < 6; ++v)
+            {
+                quad[v] = sf::Vertex(position, sf::Color::Transparent);
+            }
+            continue;
+        }
+
+        const sf::Glyph& glyph = getGlyph(text[i]);
+        const float left = x + glyph.bounds.left;
+        const float top = baseline + glyph.bounds.top;
+        const float right = left + glyph.bounds.width;
+        const float bottom = top + glyph.bounds.height;
+
+        const float u1 = static_cast<float>(glyph.textureRect.left);
+        const float v1 = static_cast<float>(glyph.textureRect.top);
+        const float u2 = u1 + glyph.textureRect.width;
+        const float v2 = v1 + glyph.textureRect.height;
+
+        quad[0] = sf::Vertex(sf::Vector2f(left, top), color, sf::Vector2f(u1, v1));
+        quad[1] = sf::Vertex(sf::Vector2f(right, top), color, sf::Vector2f(u2, v1));
+        quad[2] = sf::Vertex(sf::Vector2f(left, bottom), color, sf::Vector2f(u1, v2));
+        quad[3] = sf::Vertex(sf::Vector2f(left, bottom), color, sf::Vector2f(u1, v2));
+        quad[4] = sf::Vertex(sf::Vector2f(right, top), color, sf::Vector2f(u2, v1));
+        quad[5] = sf::Vertex(sf::Vector2f(right, bottom), color, sf::Vector2f(u2, v2));
+
+        x += glyph.advance;
+    }
+}
+
+////////////////////////////////////////////////////////////
+
+const sf::Glyph& SceneRenderer::getGlyph(char c)
+{
+    const unsigned char index = static_cast<unsigned char>(c) & 0x7F;
+    if (!glyphCached[index])
+    {
+        glyphCache[index] = font.getGlyph(index, charSize, false);
+        glyphCached[index] = true;
+    }
+    return glyphCache[index];
+}
@@ -0,0 +1,67 @@
+#include "../include/Tower.hpp"
+#include "../include/hanoi/ParallelGenerator.hpp"
+#include "../include/hanoi/FrameStewart.hpp"
+
+void moveDisk(Tower& source, Tower& destination, hanoi::MoveList& operations, bool log) {
+    source.moveTopDiskTo(destination);
+    if (log) {
+        hanoi::Move move = { source.getPeg(), destination.getPeg(), static_cast<std::uint8_t>(destination.getTopDiskIndex()) };
+        operations.push_back(move);
+    }
+}
+
+void solveHanoi(int n, std::vector<Tower*>& towers, Tower& source, Tower& destination, hanoi::MoveList& operations) {
+    const std::uint64_t first = operations.size();
+    if (towers.size() == 3) {
+        hanoi::MoveGenerator generator(n, source.getPeg(), destination.getPeg());
+        operations.resize(first + generator.size());
+        hanoi::generateMoves(generator, 0, generator.size(), operations.data() + first);
+    } else {
+        // Con mas de tres torres, Frame-Stewart
+        hanoi::FrameStewartGenerator generator(n, towers.size(), source.getPeg(), destination.getPeg());
+        operations.resize(first + generator.size());
+        hanoi::generateMoves(generator, 0, generator.size(), operations.data() + first);
+    }
+}
+
+void setDisks(hanoi::Board &board, std::vector<Disk> &disks, DiskGeometry &geometry, Tower &a, int numDisks, const SceneLayout &layout, std::vector<sf::Color> &colors, int numPegs) {
+    board.reset(numDisks, numPegs, a.getPeg());
+    geometry.resize(numDisks);
+    disks.clear();
+    disks.reserve(numDisks);
+    // disks[0] es el disco mas pequeno; se muestra con el numero numDisks - 1
+    for (int i = 0; i < numDisks; ++i) {
+        geometry.color[i] = colors[(numDisks - 1 - i) % colors.size()];
+        disks.push_back(Disk(geometry, i));
+    }
+    geometry.applyLayout(layout);
+    a.placeDisks();
+}
+
+void applyLayout(DiskGeometry &geometry, std::vector<Tower*> &towers, const SceneLayout &layout) {
+    geometry.applyLayout(layout);
+    for (Tower* tower : towers) {
+        tower->placeDisks();
+    }
+}
+
+void seekOperation(hanoi::Board &board, std::vector<Tower*> &towers, int numDisks, Tower &source, Tower &destination, std::uint64_t movesDone) {
+    board = hanoi::FrameStewartGenerator(numDisks, board.getNumPegs(), source.getPeg(), destination.getPeg()).stateAfter(movesDone);
+    for (Tower* tower : towers) {
+        tower->placeDisks();
+    }
+}
+
+void placeState(hanoi::Board &board, std::vector<Tower*> &towers, const hanoi::Board &state) {
+    board = state;
+    for (Tower* tower : towers) {
+        tower->placeDisks();
+    }
+}
+
+std::uint64_t calcularNMovimientos(int numDiscos, int numTorres) {
+    if (numTorres != 3) {
+        return hanoi::SplitTable::get().cost(numDiscos, numTorres);
+    }
+    return hanoi::MoveGenerator(numDiscos).size();
+}
@@ -0,0 +1,191 @@
+#include "../../include/hanoi/AsyncLogger.hpp"
+#include "../../include/hanoi/MoveText.hpp"
+
+#include <charconv>
+
+////////////////////////////////////////////////////////////
+///
+/// @category AsyncLogger methods
+///
+////////////////////////////////////////////////////////////
+
+namespace hanoi
+{
+    namespace
+    {
+        // How long the writer sleeps when the ring is empty
+        const std::chrono::milliseconds IdleWait(2);
+
+        const char RestartLine[] = "Reiniciando...\n";
+
+        // "12.345 ": seconds with milliseconds
+        std::size_t formatTime(char* out, std::uint64_t nanoseconds)
+        {
+            const std::uint64_t milliseconds = nanoseconds / 1000000;
+            char* end = std::to_chars(out, out + 24, milliseconds / 1000).ptr;
+            const unsigned int fraction = milliseconds % 1000;
+            *end++ = '.';
+            *end++ = static_cast<char>('0' + fraction / 100);
+            *end++ = static_cast<char>('0' + fraction / 10 % 10);
+            *end++ = static_cast<char>('0' + fraction % 10);
+            *end++ = ' ';
+            return end - out;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    AsyncLogger::AsyncLogger() : head(0), tail(0), dropped(0), running(false), stream(nullptr)
+    {
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    AsyncLogger::~AsyncLogger()
+    {
+        stop();
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    bool AsyncLogger::start(std::FILE* stream)
+    {
+        stop();
+        if (!stream)
+        {
+            return false;
+        }
+
+        this->stream = stream;
+        head = 0;
+        tail = 0;
+        dropped = 0;
+        startTime = std::chrono::steady_clock::now();
+        running = true;
+        writer = std::thread(&AsyncLogger::run, this);
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    void AsyncLogger::stop()
+    {
+        if (writer.joinable())
+        {
+            running.store(false, std::memory_order_release);
+            writer.join();
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    bool AsyncLogger::logMove(const Move& move, std::uint64_t index, std::uint64_t total, unsigned int numDisks)
+    {
+        LogRecord record;
+        record.kind = LogRecord::MoveEvent;
+        record.index = index;
+        record.total = total;
+        record.numDisks = static_cast<std::uint8_t>(numDisks);
+        record.move = move;
+        return push(record);
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    bool AsyncLogger::logRestart()
+    {
+        LogRecord record = {};
+        record.kind = LogRecord::RestartEvent;
+        return push(record);
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    bool AsyncLogger::push(LogRecord& record)
+    {
+        if (!writer.joinable())
+        {
+            return false;
+        }
+
+        const std::uint64_t position = head.load(std::memory_order_relaxed);
+        if (position - tail.load(std::memory_order_acquire) == Capacity)
+        {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        record.time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime).count();
+        ring[position & (Capacity - 1)] = record;
+        head.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    void AsyncLogger::run()
+    {
+        MoveTextWriter text;
+        unsigned int numDisks = 0;
+        std::uint64_t total = 0;
+        std::uint64_t reported = 0;
+        text.open(stream, MoveTextWriter::Verbose, numDisks, total);
+
+        for (;;)
+        {
+            // Read before draining: every record pushed before stop() is drained below
+            const bool stopping = !running.load(std::memory_order_acquire);
+
+            std::uint64_t position = tail.load(std::memory_order_relaxed);
+            const std::uint64_t end = head.load(std::memory_order_acquire);
+            for (; position != end; ++position)
+            {
+                const LogRecord& record = ring[position & (Capacity - 1)];
+                char prefix[32];
+                text.write(prefix, formatTime(prefix, record.time));
+
+                if (record.kind == LogRecord::RestartEvent)
+                {
+                    text.write(RestartLine, sizeof(RestartLine) - 1);
+                }
+                else
+                {
+                    if (record.numDisks != numDisks || record.total != total)
+                    {
+                        // Reopening on the same stream keeps the buffered lines and their order
+                        numDisks = record.numDisks;
+                        total = record.total;
+                        text.open(stream, MoveTextWriter::Verbose, numDisks, total);
+                    }
+                    text.write(record.move, record.index);
+                }
+                tail.store(position + 1, std::memory_order_release);
+            }
+
+            const std::uint64_t drops = dropped.load(std::memory_order_relaxed);
+            if (drops != reported)
+            {
+                char line[64];
+                char* last = std::to_chars(line, line + 24, drops - reported).ptr;
+                const char message[] = " registros descartados\n";
+                for (const char* c = message; *c; ++c)
+                {
+                    *last++ = *c;
+                }
+                text.write(line, last - line);
+                reported = drops;
+            }
+
+            text.flush();
+            if (stopping)
+            {
+                break;
+            }
+            if (end == head.load(std::memory_order_acquire))
+            {
+                std::this_thread::sleep_for(IdleWait);
+            }
+        }
+        text.close();
+    }
+}
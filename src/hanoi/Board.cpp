@@ -0,0 +1,96 @@
+#include "../../include/hanoi/Board.hpp"
+
+////////////////////////////////////////////////////////////
+///
+/// @category Board methods
+///
+////////////////////////////////////////////////////////////
+
+namespace hanoi
+{
+    Board::Board()
+    {
+        reset(0);
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    Board::Board(unsigned int numDisks, unsigned int numPegs, Peg start)
+    {
+        reset(numDisks, numPegs, start);
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    void Board::reset(unsigned int numDisks, unsigned int numPegs, Peg start)
+    {
+        this->numDisks = numDisks > MaxDisks ? MaxDisks : numDisks;
+        this->numPegs = numPegs > MaxPegs ? MaxPegs : numPegs;
+        for (unsigned int i = 0; i < MaxPegs; ++i)
+        {
+            pegs[i] = 0;
+        }
+        pegs[start] = getAllDisks();
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    bool Board::tryMove(Peg source, Peg destination)
+    {
+        if (source >= numPegs || destination >= numPegs || !canMove(source, destination))
+        {
+            return false;
+        }
+        move(source, destination);
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    Peg Board::pegOf(unsigned int disk) const
+    {
+        const std::uint64_t bit = std::uint64_t(1) << disk;
+        for (unsigned int peg = 0; peg < numPegs; ++peg)
+        {
+            if (pegs[peg] & bit)
+            {
+                return static_cast<Peg>(peg);
+            }
+        }
+        return static_cast<Peg>(numPegs);
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    bool Board::isValid() const
+    {
+        std::uint64_t seen = 0;
+        for (unsigned int peg = 0; peg < numPegs; ++peg)
+        {
+            if (seen & pegs[peg])
+            {
+                return false;
+            }
+            seen |= pegs[peg];
+        }
+        return seen == getAllDisks();
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    bool Board::operator==(const Board& other) const
+    {
+        if (numDisks != other.numDisks || numPegs != other.numPegs)
+        {
+            return false;
+        }
+        for (unsigned int peg = 0; peg < numPegs; ++peg)
+        {
+            if (pegs[peg] != other.pegs[peg])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
@@ -0,0 +1,251 @@
+#include "../../include/hanoi/DistanceTable.hpp"
+#include "../../include/hanoi/ParallelGenerator.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+////////////////////////////////////////////////////////////
+///
+/// @category Distance table generation
+///
+////////////////////////////////////////////////////////////
+
+namespace hanoi
+{
+    namespace
+    {
+        // Prefix blocks per worker, so uneven cores still finish together
+        const std::uint64_t BlocksPerWorker = 8;
+
+        // Fills the 3^disks entries of a block whose larger disks already cost base moves
+        template <typename Entry>
+        void fillBlock(Entry* out, unsigned int disks, unsigned int target, std::uint32_t base, const std::uint64_t* powers)
+        {
+            if (disks == 1)
+            {
+                out[0] = static_cast<Entry>(target == 0 ? base : base + 1);
+                out[1] = static_cast<Entry>(target == 1 ? base : base + 1);
+                out[2] = static_cast<Entry>(target == 2 ? base : base + 1);
+                return;
+            }
+
+            const std::uint64_t size = powers[disks - 1];
+            const std::uint32_t step = std::uint32_t(1) << (disks - 1);
+            for (unsigned int peg = 0; peg < 3; ++peg)
+            {
+                if (peg == target)
+                {
+                    fillBlock(out + peg * size, disks - 1, target, base, powers);
+                }
+                else
+                {
+                    fillBlock(out + peg * size, disks - 1, 3 - peg - target, base + step, powers);
+                }
+            }
+        }
+
+        template <typename Entry>
+        void fillTable(Entry* out, unsigned int numDisks, Peg goal, unsigned int threads)
+        {
+            std::uint64_t powers[MaxSearchDisks + 1];
+            powers[0] = 1;
+            for (unsigned int i = 1; i <= MaxSearchDisks; ++i)
+            {
+                powers[i] = powers[i - 1] * 3;
+            }
+
+            if (numDisks == 0)
+            {
+                out[0] = 0;
+                return;
+            }
+
+            // The digits of the prefixLength largest disks pick a block of 3^(n - prefixLength) states
+            const unsigned int workers = workerCount(threads, powers[numDisks]);
+            unsigned int prefixLength = 0;
+            while (prefixLength < numDisks - 1 && powers[prefixLength] < workers * BlocksPerWorker)
+            {
+                ++prefixLength;
+            }
+            const unsigned int blockDisks = numDisks - prefixLength;
+            const std::uint64_t blocks = powers[prefixLength];
+            std::atomic<std::uint64_t> nextBlock(0);
+
+            auto work = [&]()
+            {
+                for (std::uint64_t prefix = nextBlock++; prefix < blocks; prefix = nextBlock++)
+                {
+                    unsigned int target = goal;
+                    std::uint32_t base = 0;
+                    for (int digit = static_cast<int>(prefixLength) - 1; digit >= 0; --digit)
+                    {
+                        const unsigned int peg = (prefix / powers[digit]) % 3;
+                        if (peg != target)
+                        {
+                            base += std::uint32_t(1) << (blockDisks + digit);
+                            target = 3 - peg - target;
+                        }
+                    }
+                    fillBlock(out + prefix * powers[blockDisks], blockDisks, target, base, powers);
+                }
+            };
+
+            std::vector<std::thread> pool;
+            for (unsigned int w = 1; w < workers; ++w)
+            {
+                pool.push_back(std::thread(work));
+            }
+            work();
+            for (std::thread& thread : pool)
+            {
+                thread.join();
+            }
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    unsigned int distanceWidth(unsigned int numDisks)
+    {
+        return numDisks <= 8 ? 1 : numDisks <= 16 ? 2 : 4;
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    bool writeDistanceTable(const std::string& path, unsigned int numDisks, Peg goal, unsigned int threads)
+    {
+        if (numDisks > MaxSearchDisks || goal > 2)
+        {
+            return false;
+        }
+
+        DistanceTableHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, DistanceTableMagic, sizeof(header.magic));
+        header.version = DistanceTableVersion;
+        header.numDisks = static_cast<std::uint8_t>(numDisks);
+        header.goal = goal;
+        header.width = static_cast<std::uint8_t>(distanceWidth(numDisks));
+        header.count = stateCount(numDisks);
+
+        const std::size_t bytes = sizeof(header) + header.count * header.width;
+        int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0)
+        {
+            return false;
+        }
+        if (::ftruncate(fd, bytes) != 0)
+        {
+            ::close(fd);
+            return false;
+        }
+
+        // Workers write straight into the page cache; no copy of the table is kept in memory
+        void* data = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (data == MAP_FAILED)
+        {
+            return false;
+        }
+
+        std::memcpy(data, &header, sizeof(header));
+        void* entries = static_cast<char*>(data) + sizeof(header);
+        switch (header.width)
+        {
+            case 1: fillTable(static_cast<std::uint8_t*>(entries), numDisks, goal, threads); break;
+            case 2: fillTable(static_cast<std::uint16_t*>(entries), numDisks, goal, threads); break;
+            default: fillTable(static_cast<std::uint32_t*>(entries), numDisks, goal, threads); break;
+        }
+
+        const bool synced = ::msync(data, bytes, MS_SYNC) == 0;
+        return ::munmap(data, bytes) == 0 && synced;
+    }
+
+    ////////////////////////////////////////////////////////////
+    ///
+    /// @category DistanceTable methods
+    ///
+    ////////////////////////////////////////////////////////////
+
+    DistanceTable::DistanceTable() : mapping(nullptr), mappingSize(0), entries(nullptr)
+    {
+        std::memset(&header, 0, sizeof(header));
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    DistanceTable::~DistanceTable()
+    {
+        close();
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    bool DistanceTable::open(const std::string& path)
+    {
+        close();
+
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            return false;
+        }
+
+        struct stat info;
+        if (::fstat(fd, &info) != 0 || static_cast<std::uint64_t>(info.st_size) < sizeof(DistanceTableHeader))
+        {
+            ::close(fd);
+            return false;
+        }
+
+        void* data = ::mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (data == MAP_FAILED)
+        {
+            return false;
+        }
+
+        DistanceTableHeader fileHeader;
+        std::memcpy(&fileHeader, data, sizeof(fileHeader));
+        if (std::memcmp(fileHeader.magic, DistanceTableMagic, sizeof(fileHeader.magic)) != 0
+            || fileHeader.version != DistanceTableVersion
+            || fileHeader.numDisks > MaxSearchDisks
+            || fileHeader.goal > 2
+            || fileHeader.width != distanceWidth(fileHeader.numDisks)
+            || fileHeader.count != stateCount(fileHeader.numDisks)
+            || (info.st_size - sizeof(DistanceTableHeader)) / fileHeader.width < fileHeader.count)
+        {
+            ::munmap(data, info.st_size);
+            return false;
+        }
+
+        // Lookups follow the game state, which jumps around the table
+        ::madvise(data, info.st_size, MADV_RANDOM);
+
+        header = fileHeader;
+        mapping = data;
+        mappingSize = info.st_size;
+        entries = static_cast<const std::uint8_t*>(data) + sizeof(DistanceTableHeader);
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    void DistanceTable::close()
+    {
+        if (mapping)
+        {
+            ::munmap(mapping, mappingSize);
+        }
+        mapping = nullptr;
+        mappingSize = 0;
+        entries = nullptr;
+        std::memset(&header, 0, sizeof(header));
+    }
+}
@@ -0,0 +1,314 @@
+#include "../../include/hanoi/FrameStewart.hpp"
+#include "../../include/hanoi/StateQuery.hpp"
+
+////////////////////////////////////////////////////////////
+///
+/// @category Frame-Stewart solver
+///
+////////////////////////////////////////////////////////////
+
+namespace hanoi
+{
+    namespace
+    {
+        const std::uint64_t Saturated = ~std::uint64_t(0);
+
+        std::uint64_t saturatingAdd(std::uint64_t a, std::uint64_t b)
+        {
+            return a > Saturated - b ? Saturated : a + b;
+        }
+
+        // Lowest peg of mask other than the two given ones
+        Peg freePeg(std::uint16_t mask, Peg a, Peg b)
+        {
+            const std::uint16_t free = mask & ~(1u << a) & ~(1u << b);
+            return static_cast<Peg>(__builtin_ctz(free));
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    const SplitTable& SplitTable::get()
+    {
+        static const SplitTable table;
+        return table;
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    SplitTable::SplitTable()
+    {
+        // Row p only needs row p - 1 and its own smaller entries; the whole
+        // table is about 16 * 64 * 64 steps, far below the cost of a thread
+        for (unsigned int p = 0; p <= MaxPegs; ++p)
+        {
+            for (unsigned int n = 0; n <= MaxDisks; ++n)
+            {
+                splits[p][n] = 0;
+                if (n == 0)
+                {
+                    costs[p][n] = 0;
+                }
+                else if (p < 3)
+                {
+                    costs[p][n] = n == 1 && p == 2 ? 1 : Saturated;
+                }
+                else if (p == 3 || n == 1)
+                {
+                    costs[p][n] = n >= 64 ? Saturated : (std::uint64_t(1) << n) - 1;
+                }
+                else
+                {
+                    std::uint64_t best = Saturated;
+                    unsigned int bestSplit = 1;
+                    for (unsigned int k = 1; k < n; ++k)
+                    {
+                        const std::uint64_t moves = saturatingAdd(saturatingAdd(costs[p][k], costs[p][k]), costs[p - 1][n - k]);
+                        if (moves < best)
+                        {
+                            best = moves;
+                            bestSplit = k;
+                        }
+                    }
+                    costs[p][n] = best;
+                    splits[p][n] = static_cast<std::uint8_t>(bestSplit);
+                }
+            }
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    FrameStewartGenerator::FrameStewartGenerator(unsigned int numDisks, unsigned int numPegs)
+        : numDisks(numDisks), numPegs(numPegs), from(0), to(static_cast<Peg>(numPegs - 1)),
+          total(SplitTable::get().cost(numDisks, numPegs)), table(SplitTable::get())
+    {
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    FrameStewartGenerator::FrameStewartGenerator(unsigned int numDisks, unsigned int numPegs, Peg from, Peg to)
+        : numDisks(numDisks), numPegs(numPegs), from(from), to(to),
+          total(SplitTable::get().cost(numDisks, numPegs)), table(SplitTable::get())
+    {
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    FrameStewartGenerator::Frame FrameStewartGenerator::root() const
+    {
+        Frame frame = {};
+        frame.count = static_cast<std::uint8_t>(numDisks);
+        frame.lowest = 0;
+        frame.source = from;
+        frame.destination = to;
+        frame.mask = static_cast<std::uint16_t>((1u << numPegs) - 1);
+        return frame;
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    bool FrameStewartGenerator::isLeaf(const Frame& frame) const
+    {
+        return table.split(frame.count, __builtin_popcount(frame.mask)) == 0;
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    std::uint64_t FrameStewartGenerator::frameSize(const Frame& frame) const
+    {
+        return table.cost(frame.count, __builtin_popcount(frame.mask));
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    FrameStewartGenerator::Frame FrameStewartGenerator::child(const Frame& frame, unsigned int stage) const
+    {
+        const unsigned int k = table.split(frame.count, __builtin_popcount(frame.mask));
+        const Peg via = freePeg(frame.mask, frame.source, frame.destination);
+
+        Frame next = frame;
+        next.stage = 0;
+        next.index = 0;
+        if (stage == 0)
+        {
+            // Top k disks out of the way, with every peg
+            next.count = static_cast<std::uint8_t>(k);
+            next.destination = via;
+        }
+        else if (stage == 1)
+        {
+            // The rest to the goal, without the peg holding the k disks
+            next.count = static_cast<std::uint8_t>(frame.count - k);
+            next.lowest = static_cast<std::uint8_t>(frame.lowest + k);
+            next.mask = static_cast<std::uint16_t>(frame.mask & ~(1u << via));
+        }
+        else
+        {
+            // The k disks on top of them
+            next.count = static_cast<std::uint8_t>(k);
+            next.source = via;
+        }
+        return next;
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    unsigned int FrameStewartGenerator::childStage(const Frame& frame, std::uint64_t& index) const
+    {
+        const unsigned int pegs = __builtin_popcount(frame.mask);
+        const unsigned int k = table.split(frame.count, pegs);
+        const std::uint64_t aside = table.cost(k, pegs);
+        const std::uint64_t middle = table.cost(frame.count - k, pegs - 1);
+        if (index < aside)
+        {
+            return 0;
+        }
+        index -= aside;
+        if (index < middle)
+        {
+            return 1;
+        }
+        index -= middle;
+        return 2;
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    Move FrameStewartGenerator::leafMove(const Frame& frame, std::uint64_t index) const
+    {
+        // Same closed form as MoveGenerator, on the frame's three pegs
+        const Peg pegs[3] = { frame.source, freePeg(frame.mask, frame.source, frame.destination), frame.destination };
+        const std::uint64_t k = index + 1;
+        const unsigned int disk = __builtin_ctzll(k);
+        const unsigned int j = ((k >> disk) >> 1) % 3;
+        const unsigned int direction = ((frame.count - disk) & 1) ? 2 : 1;
+
+        Move move;
+        move.source = pegs[(j * direction) % 3];
+        move.destination = pegs[((j + 1) * direction) % 3];
+        move.disk = static_cast<std::uint8_t>(frame.lowest + disk);
+        return move;
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    Move FrameStewartGenerator::at(std::uint64_t index) const
+    {
+        Frame frame = root();
+        while (!isLeaf(frame))
+        {
+            frame = child(frame, childStage(frame, index));
+        }
+        return leafMove(frame, index);
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    Board FrameStewartGenerator::stateAfter(std::uint64_t movesDone) const
+    {
+        Board board(numDisks, numPegs, from);
+        std::uint64_t masks[MaxPegs] = {};
+
+        Frame frame = root();
+        while (!isLeaf(frame))
+        {
+            const unsigned int k = table.split(frame.count, __builtin_popcount(frame.mask));
+            const Peg via = freePeg(frame.mask, frame.source, frame.destination);
+            const std::uint64_t big = frame.count >= 64 ? Saturated : ((std::uint64_t(1) << frame.count) - 1);
+            const std::uint64_t small = (std::uint64_t(1) << k) - 1;
+            const std::uint64_t larger = (big & ~small) << frame.lowest;
+            const std::uint64_t smaller = small << frame.lowest;
+
+            const unsigned int stage = childStage(frame, movesDone);
+            if (stage == 0)
+            {
+                masks[frame.source] |= larger;
+            }
+            else if (stage == 1)
+            {
+                masks[via] |= smaller;
+            }
+            else
+            {
+                masks[frame.destination] |= larger;
+            }
+            frame = child(frame, stage);
+        }
+
+        // Three-peg leaf: the closed form on pegs 0, 1, 2 mapped onto the frame's pegs
+        const Peg pegs[3] = { frame.source, freePeg(frame.mask, frame.source, frame.destination), frame.destination };
+        const Board leaf = hanoi::stateAfter(frame.count, movesDone, 0, 2);
+        for (int role = 0; role < 3; ++role)
+        {
+            masks[pegs[role]] |= leaf.getPeg(role) << frame.lowest;
+        }
+
+        for (Peg peg = 0; peg < numPegs; ++peg)
+        {
+            board.setPeg(peg, masks[peg]);
+        }
+        return board;
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    FrameStewartGenerator::Cursor::Cursor(const FrameStewartGenerator& generator, std::uint64_t first)
+        : generator(&generator), depth(0)
+    {
+        if (first >= generator.size())
+        {
+            return;
+        }
+
+        // Walk down to the move at index first, keeping the path
+        stack[0] = generator.root();
+        depth = 1;
+        while (!generator.isLeaf(stack[depth - 1]))
+        {
+            Frame& frame = stack[depth - 1];
+            frame.stage = static_cast<std::uint8_t>(generator.childStage(frame, first));
+            stack[depth] = generator.child(frame, frame.stage);
+            depth++;
+        }
+        stack[depth - 1].index = first;
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    Move FrameStewartGenerator::Cursor::next()
+    {
+        Frame& leaf = stack[depth - 1];
+        const Move move = generator->leafMove(leaf, leaf.index++);
+        if (leaf.index == generator->frameSize(leaf))
+        {
+            depth--;
+            descend();
+        }
+        return move;
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    void FrameStewartGenerator::Cursor::descend()
+    {
+        // Next unfinished stage of the nearest parent, then its first leaf
+        while (depth > 0 && stack[depth - 1].stage == 2)
+        {
+            depth--;
+        }
+        if (depth == 0)
+        {
+            return;
+        }
+        Frame& parent = stack[depth - 1];
+        parent.stage++;
+        stack[depth] = generator->child(parent, parent.stage);
+        depth++;
+        while (!generator->isLeaf(stack[depth - 1]))
+        {
+            stack[depth] = generator->child(stack[depth - 1], 0);
+            depth++;
+        }
+    }
+}
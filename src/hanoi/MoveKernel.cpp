@@ -0,0 +1,246 @@
+#include "../../include/hanoi/MoveKernel.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define HANOI_KERNEL_X86
+    #include <immintrin.h>
+#endif
+
+////////////////////////////////////////////////////////////
+///
+/// @category Batch move kernels
+///
+////////////////////////////////////////////////////////////
+
+namespace hanoi
+{
+    namespace
+    {
+        // Per-lane constants for a batch of Lanes moves; lane 0 is patched per batch
+        struct LaneTables
+        {
+            std::uint16_t countFactor[16];  // 2^(log2(Lanes) - d - 1) mod 3
+            std::uint16_t countOffset[16];  // (j >> (d + 1)) mod 3
+            std::uint16_t direction[16];    // 1 for 0->1->2, 2 for 0->2->1
+            std::uint16_t disk[16];         // d << 8, ready to be OR-ed into the record
+        };
+
+        void buildLanes(const MoveGenerator& generator, unsigned int lanes, LaneTables& tables)
+        {
+            const unsigned int shift = __builtin_ctz(lanes);
+            for (unsigned int j = 0; j < 16; ++j)
+            {
+                tables.countFactor[j] = 0;
+                tables.countOffset[j] = 0;
+                tables.direction[j] = 0;
+                tables.disk[j] = 0;
+            }
+            for (unsigned int j = 1; j < lanes; ++j)
+            {
+                const unsigned int disk = __builtin_ctz(j);
+                tables.countFactor[j] = ((shift - disk - 1) & 1) ? 2 : 1;
+                tables.countOffset[j] = (j >> (disk + 1)) % 3;
+                tables.direction[j] = ((generator.getNumDisks() - disk) & 1) ? 2 : 1;
+                tables.disk[j] = static_cast<std::uint16_t>(disk << 8);
+            }
+        }
+
+        void scalarMoves(const MoveGenerator& generator, std::uint64_t first, std::uint64_t count, PackedMove* out)
+        {
+            for (std::uint64_t i = 0; i < count; ++i)
+            {
+                out[i] = packMove(generator[first + i]);
+            }
+        }
+
+#ifdef HANOI_KERNEL_X86
+
+        ////////////////////////////////////////////////////////////
+        // SSE2: 8 moves per batch
+        ////////////////////////////////////////////////////////////
+
+        __attribute__((target("sse2")))
+        inline __m128i mod3Step(__m128i x)
+        {
+            const __m128i mask = _mm_cmpgt_epi16(x, _mm_set1_epi16(2));
+            return _mm_sub_epi16(x, _mm_and_si128(mask, _mm_set1_epi16(3)));
+        }
+
+        __attribute__((target("sse2")))
+        inline __m128i mapPegs(__m128i role, __m128i peg0, __m128i peg1, __m128i peg2)
+        {
+            const __m128i is0 = _mm_cmpeq_epi16(role, _mm_setzero_si128());
+            const __m128i is1 = _mm_cmpeq_epi16(role, _mm_set1_epi16(1));
+            const __m128i is2 = _mm_cmpeq_epi16(role, _mm_set1_epi16(2));
+            return _mm_or_si128(_mm_and_si128(is0, peg0), _mm_or_si128(_mm_and_si128(is1, peg1), _mm_and_si128(is2, peg2)));
+        }
+
+        __attribute__((target("sse2")))
+        void sse2Batches(const MoveGenerator& generator, std::uint64_t first, std::uint64_t batches, PackedMove* out)
+        {
+            LaneTables tables;
+            buildLanes(generator, 8, tables);
+            const __m128i countFactor = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tables.countFactor));
+            const __m128i countOffset = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tables.countOffset));
+            const __m128i direction = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tables.direction));
+            const __m128i disk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tables.disk));
+            const __m128i one = _mm_set1_epi16(1);
+            const __m128i peg0 = _mm_set1_epi16(generator.getPeg(0));
+            const __m128i peg1 = _mm_set1_epi16(generator.getPeg(1));
+            const __m128i peg2 = _mm_set1_epi16(generator.getPeg(2));
+
+            std::uint64_t k = first + 1;
+            unsigned int batchMod3 = (k >> 3) % 3;
+            for (std::uint64_t i = 0; i < batches; ++i, k += 8)
+            {
+                // Moves already made by each lane's disk, mod 3
+                __m128i count = _mm_add_epi16(_mm_mullo_epi16(_mm_set1_epi16(batchMod3), countFactor), countOffset);
+                count = mod3Step(mod3Step(count));
+
+                __m128i source = mod3Step(_mm_mullo_epi16(count, direction));
+                __m128i destination = mod3Step(mod3Step(_mm_mullo_epi16(_mm_add_epi16(count, one), direction)));
+                source = mapPegs(source, peg0, peg1, peg2);
+                destination = mapPegs(destination, peg0, peg1, peg2);
+
+                __m128i packed = _mm_or_si128(_mm_or_si128(source, _mm_slli_epi16(destination, 4)), disk);
+                packed = _mm_insert_epi16(packed, packMove(generator[k - 1]), 0);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 8), packed);
+
+                batchMod3 = batchMod3 == 2 ? 0 : batchMod3 + 1;
+            }
+        }
+
+        ////////////////////////////////////////////////////////////
+        // AVX2: 16 moves per batch
+        ////////////////////////////////////////////////////////////
+
+        __attribute__((target("avx2")))
+        inline __m256i mod3Step256(__m256i x)
+        {
+            const __m256i mask = _mm256_cmpgt_epi16(x, _mm256_set1_epi16(2));
+            return _mm256_sub_epi16(x, _mm256_and_si256(mask, _mm256_set1_epi16(3)));
+        }
+
+        __attribute__((target("avx2")))
+        inline __m256i mapPegs256(__m256i role, __m256i peg0, __m256i peg1, __m256i peg2)
+        {
+            const __m256i is0 = _mm256_cmpeq_epi16(role, _mm256_setzero_si256());
+            const __m256i is1 = _mm256_cmpeq_epi16(role, _mm256_set1_epi16(1));
+            const __m256i is2 = _mm256_cmpeq_epi16(role, _mm256_set1_epi16(2));
+            return _mm256_or_si256(_mm256_and_si256(is0, peg0), _mm256_or_si256(_mm256_and_si256(is1, peg1), _mm256_and_si256(is2, peg2)));
+        }
+
+        __attribute__((target("avx2")))
+        void avx2Batches(const MoveGenerator& generator, std::uint64_t first, std::uint64_t batches, PackedMove* out)
+        {
+            LaneTables tables;
+            buildLanes(generator, 16, tables);
+            const __m256i countFactor = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tables.countFactor));
+            const __m256i countOffset = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tables.countOffset));
+            const __m256i direction = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tables.direction));
+            const __m256i disk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tables.disk));
+            const __m256i one = _mm256_set1_epi16(1);
+            const __m256i peg0 = _mm256_set1_epi16(generator.getPeg(0));
+            const __m256i peg1 = _mm256_set1_epi16(generator.getPeg(1));
+            const __m256i peg2 = _mm256_set1_epi16(generator.getPeg(2));
+
+            std::uint64_t k = first + 1;
+            unsigned int batchMod3 = (k >> 4) % 3;
+            for (std::uint64_t i = 0; i < batches; ++i, k += 16)
+            {
+                __m256i count = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_set1_epi16(batchMod3), countFactor), countOffset);
+                count = mod3Step256(mod3Step256(count));
+
+                __m256i source = mod3Step256(_mm256_mullo_epi16(count, direction));
+                __m256i destination = mod3Step256(mod3Step256(_mm256_mullo_epi16(_mm256_add_epi16(count, one), direction)));
+                source = mapPegs256(source, peg0, peg1, peg2);
+                destination = mapPegs256(destination, peg0, peg1, peg2);
+
+                __m256i packed = _mm256_or_si256(_mm256_or_si256(source, _mm256_slli_epi16(destination, 4)), disk);
+                packed = _mm256_insert_epi16(packed, packMove(generator[k - 1]), 0);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * 16), packed);
+
+                batchMod3 = batchMod3 == 2 ? 0 : batchMod3 + 1;
+            }
+        }
+
+#endif // HANOI_KERNEL_X86
+
+        // Scalar head until move index + 1 is a multiple of lanes, vector batches, scalar tail
+        template <typename Batches>
+        void runBatched(const MoveGenerator& generator, std::uint64_t first, std::uint64_t count, PackedMove* out, unsigned int lanes, Batches batches)
+        {
+            std::uint64_t head = (lanes - (first + 1) % lanes) % lanes;
+            if (head > count)
+            {
+                head = count;
+            }
+            scalarMoves(generator, first, head, out);
+            first += head;
+            out += head;
+            count -= head;
+
+            const std::uint64_t fullBatches = count / lanes;
+            batches(generator, first, fullBatches, out);
+
+            const std::uint64_t done = fullBatches * lanes;
+            scalarMoves(generator, first + done, count - done, out + done);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    KernelPath bestKernelPath()
+    {
+#ifdef HANOI_KERNEL_X86
+        static const KernelPath path = __builtin_cpu_supports("avx2") ? Avx2Kernel
+                                     : __builtin_cpu_supports("sse2") ? Sse2Kernel
+                                     : ScalarKernel;
+        return path;
+#else
+        return ScalarKernel;
+#endif
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    const char* kernelPathName(KernelPath path)
+    {
+        switch (path)
+        {
+            case Avx2Kernel: return "avx2";
+            case Sse2Kernel: return "sse2";
+            default: return "scalar";
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    void computeMoves(const MoveGenerator& generator, std::uint64_t first, std::uint64_t count, PackedMove* out)
+    {
+        computeMoves(generator, first, count, out, bestKernelPath());
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    void computeMoves(const MoveGenerator& generator, std::uint64_t first, std::uint64_t count, PackedMove* out, KernelPath path)
+    {
+        if (path > bestKernelPath())
+        {
+            path = bestKernelPath();
+        }
+
+#ifdef HANOI_KERNEL_X86
+        if (path == Avx2Kernel)
+        {
+            runBatched(generator, first, count, out, 16, avx2Batches);
+            return;
+        }
+        if (path == Sse2Kernel)
+        {
+            runBatched(generator, first, count, out, 8, sse2Batches);
+            return;
+        }
+#endif
+        scalarMoves(generator, first, count, out);
+    }
+}
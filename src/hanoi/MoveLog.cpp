@@ -0,0 +1,202 @@
+#include "../../include/hanoi/MoveLog.hpp"
+#include "../../include/hanoi/Board.hpp"
+
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace hanoi
+{
+    namespace
+    {
+        // A board of at most MaxDisks disks on 3 to MaxPegs pegs, between two different pegs
+        bool isValidProblem(const MoveLogHeader& header)
+        {
+            return header.numDisks >= 1 && header.numDisks <= MaxDisks
+                && header.numPegs >= 3 && header.numPegs <= MaxPegs
+                && header.from < header.numPegs && header.to < header.numPegs
+                && header.from != header.to;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    MoveLogHeader makeMoveLogHeader(unsigned int numDisks, Peg from, Peg to, unsigned int numPegs, std::uint64_t count)
+    {
+        MoveLogHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, MoveLogMagic, sizeof(header.magic));
+        header.version = MoveLogVersion;
+        header.numDisks = static_cast<std::uint8_t>(numDisks);
+        header.numPegs = static_cast<std::uint8_t>(numPegs);
+        header.from = from;
+        header.to = to;
+        header.count = count;
+        return header;
+    }
+
+    ////////////////////////////////////////////////////////////
+    ///
+    /// @category MoveLogWriter methods
+    ///
+    ////////////////////////////////////////////////////////////
+
+    MoveLogWriter::MoveLogWriter() : file(nullptr), failed(false)
+    {
+        std::memset(&header, 0, sizeof(header));
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    MoveLogWriter::~MoveLogWriter()
+    {
+        close();
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    bool MoveLogWriter::open(const std::string& path, unsigned int numDisks, Peg from, Peg to, unsigned int numPegs)
+    {
+        close();
+
+        header = makeMoveLogHeader(numDisks, from, to, numPegs, 0);
+
+        file = std::fopen(path.c_str(), "wb");
+        if (!file)
+        {
+            return false;
+        }
+        failed = std::fwrite(&header, sizeof(header), 1, file) != 1;
+        buffer.reserve(BufferSize);
+        return !failed;
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    void MoveLogWriter::write(const PackedMove* moves, std::uint64_t count)
+    {
+        flush();
+        if (file && count > 0)
+        {
+            failed |= std::fwrite(moves, sizeof(PackedMove), count, file) != count;
+            header.count += count;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    void MoveLogWriter::flush()
+    {
+        if (file && !buffer.empty())
+        {
+            failed |= std::fwrite(buffer.data(), sizeof(PackedMove), buffer.size(), file) != buffer.size();
+            header.count += buffer.size();
+        }
+        buffer.clear();
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    bool MoveLogWriter::close()
+    {
+        if (!file)
+        {
+            return true;
+        }
+
+        flush();
+        // The count is only known at the end, so the header is written again
+        if (std::fseek(file, 0, SEEK_SET) != 0 || std::fwrite(&header, sizeof(header), 1, file) != 1)
+        {
+            failed = true;
+        }
+        if (std::fclose(file) != 0)
+        {
+            failed = true;
+        }
+        file = nullptr;
+        return !failed;
+    }
+
+    ////////////////////////////////////////////////////////////
+    ///
+    /// @category MoveLogReader methods
+    ///
+    ////////////////////////////////////////////////////////////
+
+    MoveLogReader::MoveLogReader() : mapping(nullptr), mappingSize(0), records(nullptr)
+    {
+        std::memset(&header, 0, sizeof(header));
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    MoveLogReader::~MoveLogReader()
+    {
+        close();
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    bool MoveLogReader::open(const std::string& path)
+    {
+        close();
+
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            return false;
+        }
+
+        struct stat info;
+        if (::fstat(fd, &info) != 0 || static_cast<std::uint64_t>(info.st_size) < sizeof(MoveLogHeader))
+        {
+            ::close(fd);
+            return false;
+        }
+
+        void* data = ::mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (data == MAP_FAILED)
+        {
+            return false;
+        }
+
+        MoveLogHeader fileHeader;
+        std::memcpy(&fileHeader, data, sizeof(fileHeader));
+        const std::uint64_t available = (info.st_size - sizeof(MoveLogHeader)) / sizeof(PackedMove);
+        if (std::memcmp(fileHeader.magic, MoveLogMagic, sizeof(fileHeader.magic)) != 0
+            || fileHeader.version != MoveLogVersion
+            || fileHeader.count > available
+            || !isValidProblem(fileHeader))
+        {
+            ::munmap(data, info.st_size);
+            return false;
+        }
+
+        // Playback reads the records in order
+        ::madvise(data, info.st_size, MADV_SEQUENTIAL);
+
+        header = fileHeader;
+        mapping = data;
+        mappingSize = info.st_size;
+        records = reinterpret_cast<const PackedMove*>(static_cast<const char*>(data) + sizeof(MoveLogHeader));
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    void MoveLogReader::close()
+    {
+        if (mapping)
+        {
+            ::munmap(mapping, mappingSize);
+        }
+        mapping = nullptr;
+        mappingSize = 0;
+        records = nullptr;
+        std::memset(&header, 0, sizeof(header));
+    }
+}
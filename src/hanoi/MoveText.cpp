@@ -0,0 +1,180 @@
+#include "../../include/hanoi/MoveText.hpp"
+
+#include <charconv>
+#include <cstring>
+
+////////////////////////////////////////////////////////////
+///
+/// @category Move text
+///
+////////////////////////////////////////////////////////////
+
+namespace hanoi
+{
+    namespace
+    {
+        const char VerboseMove[] = "] Mover disco ";
+        const char VerboseFrom[] = " de ";
+        const char VerboseTo[] = " a ";
+
+        // Copies a literal without its terminator
+        template <std::size_t Size>
+        char* append(char* out, const char (&text)[Size])
+        {
+            std::memcpy(out, text, Size - 1);
+            return out + Size - 1;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    std::size_t formatMoveText(char* out, const Move& move, std::uint64_t index, MoveTextWriter::Style style, unsigned int numDisks, std::uint64_t total)
+    {
+        char* end = out;
+        if (style == MoveTextWriter::Compact)
+        {
+            *end++ = static_cast<char>('A' + move.source);
+            *end++ = ' ';
+            *end++ = static_cast<char>('A' + move.destination);
+            *end++ = ' ';
+            end = std::to_chars(end, out + MoveTextWriter::MaxLine, numDisks - 1 - move.disk).ptr;
+        }
+        else
+        {
+            *end++ = '[';
+            end = std::to_chars(end, out + MoveTextWriter::MaxLine, index + 1).ptr;
+            if (total != 0)
+            {
+                *end++ = '/';
+                end = std::to_chars(end, out + MoveTextWriter::MaxLine, total).ptr;
+            }
+            end = append(end, VerboseMove);
+            end = std::to_chars(end, out + MoveTextWriter::MaxLine, numDisks - 1 - move.disk).ptr;
+            end = append(end, VerboseFrom);
+            *end++ = static_cast<char>('A' + move.source);
+            end = append(end, VerboseTo);
+            *end++ = static_cast<char>('A' + move.destination);
+        }
+        *end++ = '\n';
+        return end - out;
+    }
+
+    ////////////////////////////////////////////////////////////
+    ///
+    /// @category MoveTextWriter methods
+    ///
+    ////////////////////////////////////////////////////////////
+
+    MoveTextWriter::MoveTextWriter()
+        : file(nullptr), ownsFile(false), style(Compact), numDisks(0), total(0), used(0), failed(false)
+    {
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    MoveTextWriter::~MoveTextWriter()
+    {
+        close();
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    bool MoveTextWriter::open(const std::string& path, Style style, unsigned int numDisks, std::uint64_t total)
+    {
+        close();
+
+        std::FILE* created = std::fopen(path.c_str(), "wb");
+        if (!created || !open(created, style, numDisks, total))
+        {
+            if (created)
+            {
+                std::fclose(created);
+            }
+            return false;
+        }
+        ownsFile = true;
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    bool MoveTextWriter::open(std::FILE* stream, Style style, unsigned int numDisks, std::uint64_t total)
+    {
+        close();
+
+        file = stream;
+        ownsFile = false;
+        this->style = style;
+        this->numDisks = numDisks;
+        this->total = total;
+        buffer.resize(BufferSize);
+        used = 0;
+        failed = false;
+        return file != nullptr;
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    std::size_t MoveTextWriter::format(char* out, const Move& move, std::uint64_t index) const
+    {
+        return formatMoveText(out, move, index, style, numDisks, total);
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    void MoveTextWriter::write(const char* text, std::size_t length)
+    {
+        if (buffer.size() - used < length)
+        {
+            flush();
+        }
+        if (length > buffer.size())
+        {
+            failed |= file && std::fwrite(text, 1, length, file) != length;
+            return;
+        }
+        std::memcpy(buffer.data() + used, text, length);
+        used += length;
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    void MoveTextWriter::write(const PackedMove* moves, std::uint64_t count, std::uint64_t firstIndex)
+    {
+        for (std::uint64_t i = 0; i < count; ++i)
+        {
+            write(unpackMove(moves[i]), firstIndex + i);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    void MoveTextWriter::flush()
+    {
+        if (file && used > 0)
+        {
+            failed |= std::fwrite(buffer.data(), 1, used, file) != used;
+            failed |= std::fflush(file) != 0;
+        }
+        used = 0;
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    bool MoveTextWriter::close()
+    {
+        if (!file)
+        {
+            return true;
+        }
+
+        flush();
+        if (ownsFile && std::fclose(file) != 0)
+        {
+            failed = true;
+        }
+        file = nullptr;
+        ownsFile = false;
+        return !failed;
+    }
+}
@@ -0,0 +1,233 @@
+#include "../../include/hanoi/MoveVerifier.hpp"
+
+#include <cctype>
+#include <cstring>
+
+////////////////////////////////////////////////////////////
+///
+/// @category MoveVerifier methods
+///
+////////////////////////////////////////////////////////////
+
+namespace hanoi
+{
+    namespace
+    {
+        const char* skipSpaces(const char* text, const char* end)
+        {
+            while (text < end && (*text == ' ' || *text == '\t' || *text == '\r'))
+            {
+                ++text;
+            }
+            return text;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    MoveVerifier::MoveVerifier(const Board& start, const Board& goal, std::uint64_t optimal)
+        : goal(goal), numPegs(start.getNumPegs()), numDisks(start.getNumDisks()), optimal(optimal), count(0), status(Valid)
+    {
+        for (unsigned int peg = 0; peg < MaxPegs; ++peg)
+        {
+            pegs[peg] = start.getPeg(static_cast<Peg>(peg));
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    bool MoveVerifier::feed(const PackedMove* moves, std::uint64_t size)
+    {
+        if (status != Valid)
+        {
+            return false;
+        }
+
+        for (std::uint64_t i = 0; i < size; ++i)
+        {
+            const PackedMove move = moves[i];
+            const unsigned int source = move & 0x0F;
+            const unsigned int destination = (move >> 4) & 0x0F;
+            if (source >= numPegs || destination >= numPegs || source == destination)
+            {
+                count += i;
+                return reject(BadPeg);
+            }
+
+            const std::uint64_t from = pegs[source];
+            const std::uint64_t bit = from & -from;
+            if (bit == 0)
+            {
+                count += i;
+                return reject(EmptySource);
+            }
+            if (pegs[destination] & (bit - 1))
+            {
+                count += i;
+                return reject(LargerOnSmaller);
+            }
+            if (static_cast<unsigned int>(move >> 8) != static_cast<unsigned int>(__builtin_ctzll(bit)))
+            {
+                count += i;
+                return reject(WrongDisk);
+            }
+
+            pegs[source] = from ^ bit;
+            pegs[destination] |= bit;
+        }
+        count += size;
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    bool MoveVerifier::parseLine(const char* begin, const char* end)
+    {
+        begin = skipSpaces(begin, end);
+        if (begin == end)
+        {
+            return true;
+        }
+
+        unsigned int fields[3];
+        for (int field = 0; field < 3; ++field)
+        {
+            begin = skipSpaces(begin, end);
+            if (begin == end)
+            {
+                return reject(Malformed);
+            }
+
+            if (field < 2)
+            {
+                if (!std::isalpha(static_cast<unsigned char>(*begin)))
+                {
+                    return reject(Malformed);
+                }
+                fields[field] = std::toupper(static_cast<unsigned char>(*begin)) - 'A';
+                ++begin;
+            }
+            else
+            {
+                unsigned int disk = 0;
+                const char* digits = begin;
+                while (begin < end && *begin >= '0' && *begin <= '9' && disk < 256)
+                {
+                    disk = disk * 10 + (*begin - '0');
+                    ++begin;
+                }
+                if (begin == digits || disk >= MaxDisks)
+                {
+                    return reject(Malformed);
+                }
+                fields[field] = disk;
+            }
+        }
+        if (skipSpaces(begin, end) != end)
+        {
+            return reject(Malformed);
+        }
+
+        // Letters past P do not fit a packed peg; they are out of range anyway
+        if (fields[0] >= MaxPegs || fields[1] >= MaxPegs)
+        {
+            return reject(BadPeg);
+        }
+        // Text numbers disks from the largest, packed moves from the smallest
+        if (fields[2] >= numDisks)
+        {
+            return reject(WrongDisk);
+        }
+        const unsigned int disk = numDisks - 1 - fields[2];
+        const PackedMove move = static_cast<PackedMove>(fields[0] | (fields[1] << 4) | (disk << 8));
+        return feed(&move, 1);
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    bool MoveVerifier::feedText(const char* text, std::size_t length)
+    {
+        if (status != Valid)
+        {
+            return false;
+        }
+
+        const char* end = text + length;
+        if (!pending.empty())
+        {
+            // Finish the line cut at the end of the previous piece
+            const char* newline = static_cast<const char*>(std::memchr(text, '\n', length));
+            if (!newline)
+            {
+                pending.append(text, length);
+                return true;
+            }
+            pending.append(text, newline);
+            const bool ok = parseLine(pending.data(), pending.data() + pending.size());
+            pending.clear();
+            if (!ok)
+            {
+                return false;
+            }
+            text = newline + 1;
+        }
+
+        while (text < end)
+        {
+            const char* newline = static_cast<const char*>(std::memchr(text, '\n', end - text));
+            if (!newline)
+            {
+                pending.assign(text, end);
+                break;
+            }
+            if (!parseLine(text, newline))
+            {
+                return false;
+            }
+            text = newline + 1;
+        }
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    MoveVerifier::Status MoveVerifier::finish()
+    {
+        if (status == Valid && !pending.empty())
+        {
+            // The last line had no newline
+            parseLine(pending.data(), pending.data() + pending.size());
+            pending.clear();
+        }
+        if (status != Valid)
+        {
+            return status;
+        }
+
+        for (unsigned int peg = 0; peg < numPegs; ++peg)
+        {
+            if (pegs[peg] != goal.getPeg(static_cast<Peg>(peg)))
+            {
+                status = NotAtGoal;
+                return status;
+            }
+        }
+        if (optimal != 0 && count > optimal)
+        {
+            status = NotOptimal;
+        }
+        return status;
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    Board MoveVerifier::getBoard() const
+    {
+        Board board(goal.getNumDisks(), numPegs, 0);
+        for (unsigned int peg = 0; peg < numPegs; ++peg)
+        {
+            board.setPeg(static_cast<Peg>(peg), pegs[peg]);
+        }
+        return board;
+    }
+}
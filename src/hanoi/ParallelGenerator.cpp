@@ -0,0 +1,163 @@
+#include "../../include/hanoi/ParallelGenerator.hpp"
+#include "../../include/hanoi/MoveLog.hpp"
+#include "../../include/hanoi/MoveKernel.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+////////////////////////////////////////////////////////////
+///
+/// @category Parallel generation
+///
+////////////////////////////////////////////////////////////
+
+namespace hanoi
+{
+    namespace
+    {
+        // Below this many moves a thread costs more than it saves
+        const std::uint64_t MinMovesPerWorker = 1 << 16;
+
+        // Moves per pwrite when writing a log
+        const std::uint64_t ChunkMoves = 1 << 20;
+
+        // Runs work(begin, end) over [0, count) split in equal contiguous slices
+        template <typename Work>
+        void runSlices(std::uint64_t count, unsigned int workers, Work work)
+        {
+            if (workers <= 1)
+            {
+                work(0, count);
+                return;
+            }
+
+            std::vector<std::thread> pool;
+            pool.reserve(workers);
+            for (unsigned int w = 0; w < workers; ++w)
+            {
+                const std::uint64_t begin = count / workers * w + (w < count % workers ? w : count % workers);
+                const std::uint64_t end = begin + count / workers + (w < count % workers ? 1 : 0);
+                pool.push_back(std::thread(work, begin, end));
+            }
+            for (std::thread& thread : pool)
+            {
+                thread.join();
+            }
+        }
+
+        // Each slice seeks once, then streams in order
+        void streamMoves(const FrameStewartGenerator& generator, std::uint64_t first, std::uint64_t count, PackedMove* out)
+        {
+            FrameStewartGenerator::Cursor cursor(generator, first);
+            for (std::uint64_t i = 0; i < count; ++i)
+            {
+                out[i] = packMove(cursor.next());
+            }
+        }
+
+        // Sizes the log up front; each worker fills and pwrites its own slice in chunks
+        template <typename Fill>
+        bool writeLog(const std::string& path, const MoveLogHeader& header, unsigned int threads, Fill fill)
+        {
+            const std::uint64_t count = header.count;
+            if (count > MaxLogMoves || sizeof(off_t) < sizeof(std::int64_t))
+            {
+                // The file size and the slice offsets would not fit in off_t
+                return false;
+            }
+            int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if (fd < 0)
+            {
+                return false;
+            }
+            if (::pwrite(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header))
+                || ::ftruncate(fd, sizeof(header) + count * sizeof(PackedMove)) != 0)
+            {
+                ::close(fd);
+                return false;
+            }
+
+            std::atomic<bool> failed(false);
+            runSlices(count, workerCount(threads, count), [&](std::uint64_t begin, std::uint64_t end)
+            {
+                std::vector<PackedMove> buffer(end - begin < ChunkMoves ? end - begin : ChunkMoves);
+                for (std::uint64_t index = begin; index < end && !failed; index += buffer.size())
+                {
+                    const std::uint64_t chunk = end - index < buffer.size() ? end - index : buffer.size();
+                    fill(index, chunk, buffer.data());
+
+                    const std::size_t bytes = chunk * sizeof(PackedMove);
+                    const off_t offset = sizeof(header) + index * sizeof(PackedMove);
+                    if (::pwrite(fd, buffer.data(), bytes, offset) != static_cast<ssize_t>(bytes))
+                    {
+                        failed = true;
+                    }
+                }
+            });
+
+            return ::close(fd) == 0 && !failed;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    unsigned int workerCount(unsigned int threads, std::uint64_t count)
+    {
+        if (threads == 0)
+        {
+            threads = std::thread::hardware_concurrency();
+        }
+        const std::uint64_t useful = count / MinMovesPerWorker;
+        if (useful < threads)
+        {
+            threads = static_cast<unsigned int>(useful);
+        }
+        return threads > 0 ? threads : 1;
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    void generateMoves(const MoveGenerator& generator, std::uint64_t first, std::uint64_t count, PackedMove* out, unsigned int threads)
+    {
+        runSlices(count, workerCount(threads, count), [&](std::uint64_t begin, std::uint64_t end)
+        {
+            computeMoves(generator, first + begin, end - begin, out + begin);
+        });
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    bool writeSolutionLog(const std::string& path, unsigned int numDisks, Peg from, Peg to, unsigned int threads)
+    {
+        const MoveGenerator generator(numDisks, from, to);
+        const MoveLogHeader header = makeMoveLogHeader(numDisks, from, to, 3, generator.size());
+        return writeLog(path, header, threads, [&](std::uint64_t index, std::uint64_t count, PackedMove* out)
+        {
+            computeMoves(generator, index, count, out);
+        });
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    void generateMoves(const FrameStewartGenerator& generator, std::uint64_t first, std::uint64_t count, PackedMove* out, unsigned int threads)
+    {
+        runSlices(count, workerCount(threads, count), [&](std::uint64_t begin, std::uint64_t end)
+        {
+            streamMoves(generator, first + begin, end - begin, out + begin);
+        });
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    bool writeSolutionLog(const std::string& path, const FrameStewartGenerator& generator, unsigned int threads)
+    {
+        const MoveLogHeader header = makeMoveLogHeader(generator.getNumDisks(), generator.getFrom(), generator.getTo(), generator.getNumPegs(), generator.size());
+        return writeLog(path, header, threads, [&](std::uint64_t index, std::uint64_t count, PackedMove* out)
+        {
+            streamMoves(generator, index, count, out);
+        });
+    }
+}
@@ -0,0 +1,86 @@
+#include "../../include/hanoi/StateQuery.hpp"
+
+////////////////////////////////////////////////////////////
+///
+/// @category State queries
+///
+////////////////////////////////////////////////////////////
+
+namespace hanoi
+{
+    Board stateAfter(unsigned int numDisks, std::uint64_t movesDone, Peg from, Peg to)
+    {
+        Board board(numDisks, 3, from);
+        Peg source = from;
+        Peg destination = to;
+        Peg auxiliary = static_cast<Peg>(3 - from - to);
+        std::uint64_t masks[3] = { 0, 0, 0 };
+
+        for (int disk = static_cast<int>(board.getNumDisks()) - 1; disk >= 0; --disk)
+        {
+            const std::uint64_t bit = std::uint64_t(1) << disk;
+            if (movesDone & bit)
+            {
+                // The disk already reached the goal; the smaller ones move from the auxiliary peg
+                masks[destination] |= bit;
+                Peg temp = source;
+                source = auxiliary;
+                auxiliary = temp;
+            }
+            else
+            {
+                // The disk is still on the source; the smaller ones head for the auxiliary peg
+                masks[source] |= bit;
+                Peg temp = destination;
+                destination = auxiliary;
+                auxiliary = temp;
+            }
+        }
+
+        for (Peg peg = 0; peg < 3; ++peg)
+        {
+            board.setPeg(peg, masks[peg]);
+        }
+        return board;
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    bool movesDoneFor(const Board& board, std::uint64_t& movesDone, Peg from, Peg to)
+    {
+        if (board.getNumPegs() != 3 || !board.isValid())
+        {
+            return false;
+        }
+
+        Peg source = from;
+        Peg destination = to;
+        Peg auxiliary = static_cast<Peg>(3 - from - to);
+        std::uint64_t result = 0;
+
+        for (int disk = static_cast<int>(board.getNumDisks()) - 1; disk >= 0; --disk)
+        {
+            const std::uint64_t bit = std::uint64_t(1) << disk;
+            if (board.getPeg(destination) & bit)
+            {
+                result |= bit;
+                Peg temp = source;
+                source = auxiliary;
+                auxiliary = temp;
+            }
+            else if (board.getPeg(source) & bit)
+            {
+                Peg temp = destination;
+                destination = auxiliary;
+                auxiliary = temp;
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        movesDone = result;
+        return true;
+    }
+}
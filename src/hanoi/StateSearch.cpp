@@ -0,0 +1,374 @@
+#include "../../include/hanoi/StateSearch.hpp"
+#include "../../include/hanoi/ParallelGenerator.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+////////////////////////////////////////////////////////////
+///
+/// @category State space search
+///
+////////////////////////////////////////////////////////////
+
+namespace hanoi
+{
+    namespace
+    {
+        // Levels smaller than this are expanded by the calling thread alone
+        const std::size_t MinStatesPerWorker = 1 << 12;
+
+        // States a worker claims from the frontier at a time
+        const std::size_t ChunkStates = 256;
+
+        const unsigned int Unvisited = 3;
+
+        // Peg pairs and the link bit that allows them
+        const unsigned int LinkPegs[3][3] =
+        {
+            { 0, 1, LinkAB },
+            { 0, 2, LinkAC },
+            { 1, 2, LinkBC }
+        };
+
+        // 2 bits per state, 32 states per word, all starting as Unvisited
+        class DepthMarks
+        {
+            public:
+
+                explicit DepthMarks(std::uint64_t states) : words((states + 31) / 32, ~std::uint64_t(0)) {}
+
+                unsigned int get(std::uint64_t state) const
+                {
+                    return (__atomic_load_n(&words[state >> 5], __ATOMIC_RELAXED) >> ((state & 31) * 2)) & 3;
+                }
+
+                // Sets the depth only if the state is still unvisited; true for the one thread that did it
+                bool claim(std::uint64_t state, unsigned int depth)
+                {
+                    std::uint64_t* word = &words[state >> 5];
+                    const unsigned int shift = (state & 31) * 2;
+                    std::uint64_t old = __atomic_load_n(word, __ATOMIC_RELAXED);
+                    do
+                    {
+                        if (((old >> shift) & 3) != Unvisited)
+                        {
+                            return false;
+                        }
+                    }
+                    while (!__atomic_compare_exchange_n(word, &old, old & ~(std::uint64_t(depth ^ 3) << shift),
+                                                        true, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+                    return true;
+                }
+
+            private:
+
+                std::vector<std::uint64_t> words;
+        };
+
+        struct Search
+        {
+            unsigned int numDisks;
+            unsigned int links;
+            std::uint64_t powers[MaxSearchDisks + 1];
+            std::uint64_t goal;
+            DepthMarks marks;
+
+            std::vector<std::uint64_t> frontier;
+            std::vector<std::vector<std::uint64_t>> next;
+            std::atomic<std::size_t> cursor;
+            std::atomic<bool> found;
+            unsigned int depth;
+
+            Search(unsigned int numDisks, unsigned int links, std::uint64_t goal)
+                : numDisks(numDisks), links(links), goal(goal), marks(stateCount(numDisks)),
+                  cursor(0), found(false), depth(0)
+            {
+                powers[0] = 1;
+                for (unsigned int i = 1; i <= MaxSearchDisks; ++i)
+                {
+                    powers[i] = powers[i - 1] * 3;
+                }
+            }
+
+            // Writes the states one move away and the moves that reach them; at most 3
+            unsigned int expand(std::uint64_t state, std::uint64_t* neighbours, Move* moves) const
+            {
+                // The top of a peg is the smallest disk on it, so only the lowest digits matter
+                unsigned int top[3] = { numDisks, numDisks, numDisks };
+                unsigned int seen = 0;
+                std::uint64_t digits = state;
+                for (unsigned int disk = 0; disk < numDisks && seen < 3; ++disk)
+                {
+                    const unsigned int peg = digits % 3;
+                    digits /= 3;
+                    if (top[peg] == numDisks)
+                    {
+                        top[peg] = disk;
+                        ++seen;
+                    }
+                }
+
+                unsigned int count = 0;
+                for (const unsigned int* pair : LinkPegs)
+                {
+                    const unsigned int a = pair[0];
+                    const unsigned int b = pair[1];
+                    if (!(links & pair[2]) || top[a] == top[b])
+                    {
+                        continue;
+                    }
+
+                    // Between two pegs exactly one direction is legal: the smaller top disk moves
+                    const unsigned int source = top[a] < top[b] ? a : b;
+                    const unsigned int destination = a + b - source;
+                    const unsigned int disk = top[source];
+                    neighbours[count] = state + powers[disk] * destination - powers[disk] * source;
+                    moves[count].source = static_cast<Peg>(source);
+                    moves[count].destination = static_cast<Peg>(destination);
+                    moves[count].disk = static_cast<std::uint8_t>(disk);
+                    ++count;
+                }
+                return count;
+            }
+
+            // Expands frontier chunks until none are left, collecting new states in next[worker]
+            void expandLevel(unsigned int worker)
+            {
+                std::vector<std::uint64_t>& out = next[worker];
+                const unsigned int childDepth = (depth + 1) % 3;
+                std::uint64_t neighbours[3];
+                Move moves[3];
+
+                for (std::size_t begin = cursor.fetch_add(ChunkStates); begin < frontier.size(); begin = cursor.fetch_add(ChunkStates))
+                {
+                    const std::size_t end = begin + ChunkStates < frontier.size() ? begin + ChunkStates : frontier.size();
+                    for (std::size_t i = begin; i < end; ++i)
+                    {
+                        const unsigned int count = expand(frontier[i], neighbours, moves);
+                        for (unsigned int j = 0; j < count; ++j)
+                        {
+                            if (marks.claim(neighbours[j], childDepth))
+                            {
+                                out.push_back(neighbours[j]);
+                                if (neighbours[j] == goal)
+                                {
+                                    found = true;
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        };
+
+        // Worker threads that sleep between levels, so small levels cost no wake-ups
+        class LevelPool
+        {
+            public:
+
+                LevelPool(Search& search, unsigned int workers) : search(search), generation(0), pending(0), stopping(false)
+                {
+                    for (unsigned int w = 1; w < workers; ++w)
+                    {
+                        threads.push_back(std::thread(&LevelPool::run, this, w));
+                    }
+                }
+
+                ~LevelPool()
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        stopping = true;
+                    }
+                    wake.notify_all();
+                    for (std::thread& thread : threads)
+                    {
+                        thread.join();
+                    }
+                }
+
+                // Expands the current frontier with every worker, the caller included
+                void expandLevel()
+                {
+                    search.cursor = 0;
+                    if (threads.empty() || search.frontier.size() < MinStatesPerWorker)
+                    {
+                        search.expandLevel(0);
+                        return;
+                    }
+
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        pending = static_cast<unsigned int>(threads.size());
+                        ++generation;
+                    }
+                    wake.notify_all();
+                    search.expandLevel(0);
+
+                    std::unique_lock<std::mutex> lock(mutex);
+                    done.wait(lock, [this]() { return pending == 0; });
+                }
+
+            private:
+
+                void run(unsigned int worker)
+                {
+                    std::uint64_t seen = 0;
+                    for (;;)
+                    {
+                        {
+                            std::unique_lock<std::mutex> lock(mutex);
+                            wake.wait(lock, [&]() { return stopping || generation != seen; });
+                            if (stopping)
+                            {
+                                return;
+                            }
+                            seen = generation;
+                        }
+
+                        search.expandLevel(worker);
+
+                        std::lock_guard<std::mutex> lock(mutex);
+                        if (--pending == 0)
+                        {
+                            done.notify_one();
+                        }
+                    }
+                }
+
+                Search& search;
+                std::vector<std::thread> threads;
+                std::mutex mutex;
+                std::condition_variable wake;
+                std::condition_variable done;
+                std::uint64_t generation;
+                unsigned int pending;
+                bool stopping;
+        };
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    std::uint64_t stateCount(unsigned int numDisks)
+    {
+        std::uint64_t count = 1;
+        for (unsigned int i = 0; i < numDisks; ++i)
+        {
+            count *= 3;
+        }
+        return count;
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    std::uint64_t stateIndex(const Board& board)
+    {
+        std::uint64_t index = 0;
+        for (int disk = static_cast<int>(board.getNumDisks()) - 1; disk >= 0; --disk)
+        {
+            index = index * 3 + board.pegOf(static_cast<unsigned int>(disk));
+        }
+        return index;
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    Board boardFromIndex(unsigned int numDisks, std::uint64_t index)
+    {
+        Board board(numDisks, 3, 0);
+        std::uint64_t masks[3] = { 0, 0, 0 };
+        for (unsigned int disk = 0; disk < board.getNumDisks(); ++disk)
+        {
+            masks[index % 3] |= std::uint64_t(1) << disk;
+            index /= 3;
+        }
+        for (Peg peg = 0; peg < 3; ++peg)
+        {
+            board.setPeg(peg, masks[peg]);
+        }
+        return board;
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    bool findShortestPath(const Board& start, const Board& goal, MoveList& moves, unsigned int links, unsigned int threads)
+    {
+        moves.clear();
+        const unsigned int numDisks = start.getNumDisks();
+        if (numDisks > MaxSearchDisks || goal.getNumDisks() != numDisks ||
+            start.getNumPegs() != 3 || goal.getNumPegs() != 3 || !start.isValid() || !goal.isValid())
+        {
+            return false;
+        }
+
+        const std::uint64_t from = stateIndex(start);
+        const std::uint64_t to = stateIndex(goal);
+        if (from == to)
+        {
+            return true;
+        }
+
+        try
+        {
+            Search search(numDisks, links, to);
+            const unsigned int workers = workerCount(threads, ~std::uint64_t(0));
+            search.next.resize(workers);
+            search.marks.claim(from, 0);
+            search.frontier.push_back(from);
+
+            {
+                LevelPool pool(search, workers);
+                while (!search.found && !search.frontier.empty())
+                {
+                    pool.expandLevel();
+                    ++search.depth;
+
+                    // The new level becomes the frontier
+                    search.frontier.clear();
+                    for (std::vector<std::uint64_t>& part : search.next)
+                    {
+                        search.frontier.insert(search.frontier.end(), part.begin(), part.end());
+                        part.clear();
+                    }
+                }
+            }
+
+            if (!search.found)
+            {
+                return false;
+            }
+
+            // Walk back from the goal through any neighbour one level closer to the start
+            moves.resize(search.depth);
+            std::uint64_t state = to;
+            std::uint64_t neighbours[3];
+            Move steps[3];
+            for (unsigned int depth = search.depth; depth > 0; --depth)
+            {
+                const unsigned int parentDepth = (depth - 1) % 3;
+                const unsigned int count = search.expand(state, neighbours, steps);
+                for (unsigned int j = 0; j < count; ++j)
+                {
+                    if (search.marks.get(neighbours[j]) == parentDepth)
+                    {
+                        // The parent reaches this state with the opposite move
+                        const Move move = { steps[j].destination, steps[j].source, steps[j].disk };
+                        moves.data()[depth - 1] = packMove(move);
+                        state = neighbours[j];
+                        break;
+                    }
+                }
+            }
+            return true;
+        }
+        catch (const std::bad_alloc&)
+        {
+            moves.clear();
+            return false;
+        }
+    }
+}
@@ -0,0 +1,66 @@
+#include "../../include/hanoi/StaticSolution.hpp"
+
+#include <array>
+#include <utility>
+
+////////////////////////////////////////////////////////////
+///
+/// @category Compile-time solution tables
+///
+////////////////////////////////////////////////////////////
+
+namespace hanoi
+{
+    namespace
+    {
+        // Same closed form as MoveGenerator, for peg 0 to peg 2: move k
+        // (1-based) moves disk ctz(k), for the (k >> (disk + 1))-th time
+        template <unsigned int N>
+        constexpr std::array<PackedMove, (std::size_t(1) << N) - 1> buildSolution()
+        {
+            std::array<PackedMove, (std::size_t(1) << N) - 1> moves{};
+            for (std::uint32_t k = 1; k < (std::uint32_t(1) << N); ++k)
+            {
+                unsigned int disk = 0;
+                while (!((k >> disk) & 1))
+                {
+                    ++disk;
+                }
+                const unsigned int j = ((k >> disk) >> 1) % 3;
+
+                // Disks whose distance to the bottom is even turn 0->2->1, the others 0->1->2
+                const unsigned int direction = ((N - disk) & 1) ? 2 : 1;
+                const unsigned int source = (j * direction) % 3;
+                const unsigned int destination = ((j + 1) * direction) % 3;
+                moves[k - 1] = static_cast<PackedMove>(source | (destination << 4) | (disk << 8));
+            }
+            return moves;
+        }
+
+        template <unsigned int N>
+        struct SolutionTable
+        {
+            static constexpr std::array<PackedMove, (std::size_t(1) << N) - 1> moves = buildSolution<N>();
+        };
+
+        template <std::size_t... N>
+        constexpr std::array<const PackedMove*, sizeof...(N)> tablePointers(std::index_sequence<N...>)
+        {
+            return {{ SolutionTable<N + 1>::moves.data()... }};
+        }
+
+        // tables[n - 1] is the solution for n disks
+        constexpr std::array<const PackedMove*, MaxStaticDisks> tables = tablePointers(std::make_index_sequence<MaxStaticDisks>());
+
+        // Two disks: 0->1 (disk 0), 0->2 (disk 1), 1->2 (disk 0)
+        static_assert(SolutionTable<2>::moves[0] == 0x0010 && SolutionTable<2>::moves[1] == 0x0120 && SolutionTable<2>::moves[2] == 0x0021,
+                      "compile-time solution does not match MoveGenerator");
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    const PackedMove* staticSolutionTable(unsigned int numDisks)
+    {
+        return numDisks >= 1 && numDisks <= MaxStaticDisks ? tables[numDisks - 1] : nullptr;
+    }
+}
@@ -1,253 +1,339 @@
 #include <SFML/Graphics.hpp>
 #include <vector>
-#include <stack>
+#include <deque>
 #include <iostream>
+#include <sstream>
+#include <string>
 #include <thread>
 #include <chrono>
 #include <cmath>
+#include <cstdlib>
+#include <cctype>
+#include <cstdint>
+#include <algorithm>
+#include <memory>
 #include "../include/sfmlbutton.hpp"
-
-class Disk {
-public:
-    Disk(float width, float height, sf::Color color, int num) {
-        shape.setSize(sf::Vector2f(width, height));
-        shape.setFillColor(color);
-        this->num = num;
-    }
-
-    void setPosition(float x, float y) {
-        shape.setPosition(x, y);
-    }
-
-    sf::Vector2f getPosition() {
-        return shape.getPosition();
+#include "../include/Tower.hpp"
+#include "../include/Scene.hpp"
+#include "../include/SceneRenderer.hpp"
+#include "../include/FrameExporter.hpp"
+#include "../include/EmbeddedFont.hpp"
+#include "../include/PerfHud.hpp"
+#include "../include/BatchSolver.hpp"
+#include "../include/hanoi/MoveLog.hpp"
+#include "../include/hanoi/ParallelGenerator.hpp"
+#include "../include/hanoi/StateSearch.hpp"
+#include "../include/hanoi/StaticSolution.hpp"
+#include "../include/hanoi/DistanceTable.hpp"
+#include "../include/hanoi/MoveText.hpp"
+#include "../include/hanoi/AsyncLogger.hpp"
+
+// Lee una configuracion como "ACB": la torre de cada disco, del mas grande al mas chico
+bool parseState(const std::string &text, hanoi::Board &state) {
+    if (text.empty() || text.size() > hanoi::MaxSearchDisks) {
+        return false;
     }
-
-    int getNum() {
-        return num;
+    std::uint64_t masks[3] = { 0, 0, 0 };
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        const int peg = std::toupper((unsigned char)text[i]) - 'A';
+        if (peg < 0 || peg > 2) {
+            return false;
+        }
+        masks[peg] |= std::uint64_t(1) << (text.size() - 1 - i);
     }
-
-    sf::Color getColor() {
-        return shape.getFillColor();
+    state.reset(text.size(), 3, 0);
+    for (hanoi::Peg peg = 0; peg < 3; ++peg) {
+        state.setPeg(peg, masks[peg]);
     }
+    return true;
+}
 
-    sf::RectangleShape& getShape() {
-        return shape;
+// Torre por letra (A, B, ...) o por numero (0, 1, ...); -1 si no es valida
+int parsePeg(const std::string &text) {
+    if (text.size() == 1 && std::isalpha((unsigned char)text[0])) {
+        return std::toupper((unsigned char)text[0]) - 'A';
     }
+    return text.empty() || !std::isdigit((unsigned char)text[0]) ? -1 : std::atoi(text.c_str());
+}
 
-private:
-    sf::RectangleShape shape;
-    int num;
-};
-
-class Tower {
-public:
-    Tower(float x, float y, char letter) : x(x), y(y), letter(letter) {}
-    Tower(char letter) : x(0), y(0), letter(letter) {}
-
-    void addDisk(Disk disk) {
-        float diskHeight = disk.getShape().getSize().y;
-        disk.setPosition(x - disk.getShape().getSize().x / 2, y - (disks.size() + 1) * diskHeight);
-        disks.push(disk);
-    }
+void restart(bool &iniciadoVisualizacion, std::uint64_t &indiceOperacion, hanoi::Board &board, std::vector<Disk> &disks, DiskGeometry &geometry, Tower &a, int numDisks, const SceneLayout &layout, std::vector<sf::Color> &colors, hanoi::MoveList &operations, bool editable, RectButton &buttonPlus, RectButton &buttonMinus, RectButton &startButton, RectButton &restartButton) {
+    iniciadoVisualizacion = false;
+    indiceOperacion = 0;
+    setDisks(board, disks, geometry, a, numDisks, layout, colors, board.getNumPegs());
+    operations.clear();
+    buttonPlus.setButtonEnabled(editable);
+    buttonMinus.setButtonEnabled(editable);
+    restartButton.setButtonEnabled(false);
+    startButton.setButtonEnabled(true);
+}
 
-    Disk removeDisk() {
-        Disk topDisk = disks.top();
-        disks.pop();
-        return topDisk;
+int main(int argc, char* argv[]) {
+    const unsigned int FPS = 60;
+    const int MaxTowers = 8;
+    const int DefaultDisks = 3;
+    int numDisks = DefaultDisks;
+    int numPegs = 3;
+
+    // Registro binario de movimientos: --save ARCHIVO guarda la solucion,
+    // --play ARCHIVO reproduce un registro guardado en lugar de resolver.
+    // --export RUTA graba la animacion sin ventana (--export-format png|raw,
+    // --fps N cuadros por segundo del video, --speed N movimientos por segundo).
+    // --perf-csv ARCHIVO guarda al salir los tiempos de los ultimos cuadros.
+    // --pegs P usa P torres (3 a 8) y la solucion de Frame-Stewart
+    // --start / --goal CONFIG parten de y llegan a cualquier configuracion
+    // legal de 3 torres (p. ej. --start ABCA) con la solucion mas corta
+    // --distances ARCHIVO usa (o genera) la tabla de distancias de todos
+    // los estados para mostrar cuantos movimientos faltan
+    // --solve N resuelve sin ventana ni fuente (--from/--to torres,
+    // --format text|verbose|binary, --out ARCHIVO o la salida estandar) e informa
+    // el tiempo total y los movimientos por segundo; en ambos textos el disco
+    // 0 es el mas grande, como en la ventana
+    // --verify ARCHIVO comprueba un registro o un texto compacto ("-" lee
+    // la entrada estandar; --disks, --pegs, --from y --to describen el texto)
+    std::string savePath;
+    std::string perfCsvPath;
+    std::string exportPath;
+    std::string startState;
+    std::string goalState;
+    std::string distancesPath;
+    FrameExporter::Format exportFormat = FrameExporter::PngSequence;
+    unsigned int exportFps = 60;
+    float movesPerSecond = 1.f;
+    hanoi::MoveLogReader savedLog;
+    BatchOptions batch;
+    int batchFrom = 0;
+    int batchTo = -1;
+    bool solveBatch = false;
+    bool disksGiven = false;
+    std::string verifyPath;
+    // Todas las opciones llevan un valor
+    if (argc % 2 == 0) {
+        std::cerr << "Falta el valor de la opcion " << argv[argc - 1] << std::endl;
+        return 2;
     }
-
-    void reset() {
-        while (!disks.empty()) {
-            disks.pop();
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string flag = argv[i];
+        if (flag == "--perf-csv") {
+            perfCsvPath = argv[i + 1];
+        } else if (flag == "--pegs") {
+            numPegs = clamp(std::atoi(argv[i + 1]), 3, MaxTowers);
+        } else if (flag == "--disks") {
+            numDisks = clamp(std::atoi(argv[i + 1]), 1, (int)hanoi::MaxDisks);
+            disksGiven = true;
+        } else if (flag == "--export") {
+            exportPath = argv[i + 1];
+        } else if (flag == "--export-format") {
+            exportFormat = std::string(argv[i + 1]) == "raw" ? FrameExporter::RawStream : FrameExporter::PngSequence;
+        } else if (flag == "--fps") {
+            exportFps = std::max(1, std::atoi(argv[i + 1]));
+        } else if (flag == "--speed") {
+            movesPerSecond = clamp((float)std::atof(argv[i + 1]), 0.25f, 8192.f);
+        } else if (flag == "--start") {
+            startState = argv[i + 1];
+        } else if (flag == "--goal") {
+            goalState = argv[i + 1];
+        } else if (flag == "--distances") {
+            distancesPath = argv[i + 1];
+        } else if (flag == "--solve") {
+            batch.numDisks = clamp(std::atoi(argv[i + 1]), 1, (int)hanoi::MaxDisks);
+            solveBatch = true;
+        } else if (flag == "--verify") {
+            verifyPath = argv[i + 1];
+        } else if (flag == "--from") {
+            batchFrom = parsePeg(argv[i + 1]);
+        } else if (flag == "--to") {
+            batchTo = parsePeg(argv[i + 1]);
+        } else if (flag == "--format") {
+            const std::string format = argv[i + 1];
+            if (format == "binary") {
+                batch.format = BatchOptions::Binary;
+            } else if (format == "verbose") {
+                batch.format = BatchOptions::VerboseText;
+            } else if (format == "text") {
+                batch.format = BatchOptions::Text;
+            } else {
+                std::cerr << "Formato desconocido: " << format << " (text, verbose o binary)" << std::endl;
+                return 2;
+            }
+        } else if (flag == "--out") {
+            batch.outPath = argv[i + 1];
+        } else if (flag == "--save") {
+            savePath = argv[i + 1];
+        } else if (flag == "--play") {
+            // La cabecera ya se valido al abrir; aqui solo se limita el numero de torres que se dibujan
+            if (!savedLog.open(argv[i + 1]) || (int)savedLog.getNumPegs() > MaxTowers) {
+                std::cerr << "No se pudo abrir el registro " << argv[i + 1] << std::endl;
+                return 1;
+            }
+            numDisks = savedLog.getNumDisks();
+            numPegs = savedLog.getNumPegs();
+        } else {
+            std::cerr << "Opcion desconocida: " << flag << std::endl;
+            return 2;
         }
     }
 
-    bool isEmpty() const {
-        return disks.empty();
-    }
-
-    char getLetter() const {
-        return letter;
-    }
-
-    Disk& getTopDisk() {
-        return disks.top();
-    }
-
-    sf::Vector2f getPosition() const {
-        return sf::Vector2f(x, y);
-    }
-
-    void setPosition(float x, float y) {
-        this->x = x;
-        this->y = y;
+    // Modo por lotes: nada de SFML, ni siquiera la fuente
+    if (solveBatch || !verifyPath.empty()) {
+        if (batchTo < 0) {
+            batchTo = numPegs - 1;
+        }
+        if (batchFrom < 0 || batchFrom >= numPegs || batchTo < 0 || batchTo >= numPegs || batchFrom == batchTo) {
+            std::cerr << "Torres invalidas para --from/--to con " << numPegs << " torres" << std::endl;
+            return 1;
+        }
+        batch.numPegs = numPegs;
+        batch.from = batchFrom;
+        batch.to = batchTo;
+        if (!verifyPath.empty()) {
+            // Un registro trae sus discos; un texto usa --disks (--play no cuenta)
+            batch.numDisks = disksGiven ? numDisks : DefaultDisks;
+            return runVerify(verifyPath, batch);
+        }
+        return runBatch(batch);
     }
 
-    std::stack<Disk>& getDisks() {
-        return disks;
-    }
+    const bool editable = !savedLog.isOpen();
+    const bool headless = !exportPath.empty();
 
-private:
-    float x, y;
-    char letter;
-    std::stack<Disk> disks;
-};
-
-class Operation {
-    public:
-        char sourceLetter;
-        char destinationLetter;
-        int diskNum;
-        Operation(char sourceLetter, char destinationLetter, int diskNum) 
-            : sourceLetter(sourceLetter), destinationLetter(destinationLetter), diskNum(diskNum) {}
-};
-
-void moveDisk(Tower& source, Tower& destination, std::vector<Operation>& operations, bool log = true) {
-    Disk disk = source.removeDisk();
-    destination.addDisk(disk);
-    // Draw towers and disks
-    if (log) {
-        operations.push_back(Operation(source.getLetter(), destination.getLetter(), disk.getNum()));
-    }
-    std::vector<Tower*> towers = { &source, &destination };
-    for (Tower* tower : towers) {
-        std::stack<Disk> disks = tower->getDisks();
-        while (!disks.empty()) {
-            disks.pop();
+    // Sin --start se parte de todo en A, sin --goal se llega a todo en C
+    const bool customStates = editable && (!startState.empty() || !goalState.empty());
+    hanoi::Board startBoard;
+    hanoi::Board goalBoard;
+    if (customStates) {
+        if (startState.empty()) {
+            startState = std::string(goalState.size(), 'A');
         }
+        if (goalState.empty()) {
+            goalState = std::string(startState.size(), 'C');
+        }
+        if (startState.size() != goalState.size() || !parseState(startState, startBoard) || !parseState(goalState, goalBoard)) {
+            std::cerr << "Configuracion invalida: use una letra A, B o C por disco (1 a " << hanoi::MaxSearchDisks << " discos)" << std::endl;
+            return 1;
+        }
+        if (!savePath.empty()) {
+            std::cerr << "El registro solo guarda soluciones desde una torre completa; se ignora --save" << std::endl;
+            savePath.clear();
+        }
+        numDisks = startState.size();
+        numPegs = 3;
     }
-}
-
-void solveHanoi(int n, Tower& source, Tower& auxiliary, Tower& destination, std::vector<Operation>& operations, bool log = true) {
-    if (n == 1) {
-        moveDisk(source, destination, operations, log);
-        return;
+    const bool resizable = editable && !customStates;
+
+    // La tabla se genera si no existe o no corresponde; solo sirve para
+    // llegar a una torre completa y mientras no cambie el numero de discos
+    hanoi::DistanceTable distances;
+    if (!distancesPath.empty() && numPegs == 3) {
+        const hanoi::Peg goalPeg = customStates ? goalBoard.pegOf(numDisks - 1) : savedLog.isOpen() ? savedLog.getTo() : 2;
+        if (customStates && goalBoard != hanoi::Board(numDisks, 3, goalPeg)) {
+            std::cerr << "La tabla de distancias solo sirve si la meta es una torre completa" << std::endl;
+        } else if ((!distances.open(distancesPath) || (int)distances.getNumDisks() != numDisks || distances.getGoal() != goalPeg)
+                   && (!hanoi::writeDistanceTable(distancesPath, numDisks, goalPeg) || !distances.open(distancesPath))) {
+            std::cerr << "No se pudo crear la tabla de distancias " << distancesPath << std::endl;
+        }
     }
-    solveHanoi(n - 1, source, destination, auxiliary, operations, log);
-    moveDisk(source, destination, operations, log);
-    solveHanoi(n - 1, auxiliary, source, destination, operations, log);
-}
 
-void setDisks(Tower &a, Tower &b, Tower &c, int numDisks, const float windowWidth, const float diskHeight, std::vector<sf::Color> &colors) {
-    a.reset();
-    b.reset();
-    c.reset();
-    const float minWidth = 10.f;
-    const float factor = ((windowWidth / 4 - 20) - minWidth) / numDisks;
-    for (int i = 0; i < numDisks; ++i) {
-        float diskWidth = windowWidth / 4 - i * factor;
-        a.addDisk(Disk(diskWidth, diskHeight, colors[i % colors.size()], i));
+    std::uint64_t numMoves = calcularNMovimientos(numDisks, numPegs);
+    // Los controles se ubican sobre la ventana original de 900x650; la
+    // escena ocupa lo que quede por encima de ellos y sigue a la ventana
+    const float windowWidth = 900;
+    const float windowHeight = 600;
+    float sceneWidth = windowWidth;
+    float sceneHeight = windowHeight;
+    SceneLayout layout = computeLayout(numDisks, numPegs, sceneWidth, sceneHeight);
+    hanoi::MoveList operations;
+    const hanoi::MoveSequence* sequence = editable ? static_cast<const hanoi::MoveSequence*>(&operations) : &savedLog;
+
+    // Con tres torres y hasta hanoi::MaxStaticDisks discos la solucion ya
+    // viene compilada en una tabla. Desde MaxListDisks discos no se guarda
+    // en memoria: cada movimiento se calcula al reproducirlo (n = 64 son
+    // 2^64 - 1 movimientos)
+    const int MaxListDisks = 20;
+    const int MaxSavedDisks = 30;
+    hanoi::StaticSolution staticSolution;
+    std::unique_ptr<hanoi::FrameStewartGenerator> liveSolution;
+    // La busqueda entre configuraciones recorre los 3^n estados: se hace una
+    // sola vez y la solucion se conserva para cada reproduccion
+    hanoi::MoveList customSolution;
+    if (customStates) {
+        if (!hanoi::findShortestPath(startBoard, goalBoard, customSolution)) {
+            std::cerr << "No se encontro una solucion entre las configuraciones (o falto memoria)" << std::endl;
+            return 1;
+        }
+        numMoves = customSolution.size();
     }
-}
 
-sf::Color inverseLegibleColor(sf::Color color) {
-    int r = color.r;
-    int g = color.g;
-    int b = color.b;
-    if (r * 0.299 + g * 0.7 + b * 0.114 > 150) {
-        return sf::Color::Black;
+    // Sin ventana se dibuja en una textura y cada cuadro va al exportador
+    sf::RenderWindow window;
+    sf::RenderTexture exportTexture;
+    FrameExporter exporter;
+    if (headless) {
+        if (!exportTexture.create(windowWidth, windowHeight + 50) || !exporter.open(exportPath, exportFormat, windowWidth, windowHeight + 50)) {
+            std::cerr << "No se pudo iniciar la exportacion en " << exportPath << std::endl;
+            return 1;
+        }
     } else {
-        return sf::Color::White;
+        window.create(sf::VideoMode(windowWidth, windowHeight + 50), "Torre de Hanoi");
+        window.setFramerateLimit(FPS);
     }
-}
+    sf::RenderTarget& target = headless ? static_cast<sf::RenderTarget&>(exportTexture) : window;
 
-template<typename T>
-T clamp(T value, T min, T max) {
-    if (value < min) {
-        return min;
+    // Fuente incluida en el ejecutable; los tamanos de la interfaz se
+    // rasterizan aqui y no en el primer cuadro que los usa
+    sf::Font buttonFont;
+    if (!loadEmbeddedFont(buttonFont)) {
+        std::cerr << "No se pudo cargar la fuente incluida" << std::endl;
+        return 1;
     }
-    if (value > max) {
-        return max;
+    for (unsigned int charSize : { 14, 16, 20 }) {
+        prerasterize(buttonFont, UiCharacters, charSize);
     }
-    return value;
-}
-
-float linearInterpolation(float a, float b, float t) {
-    return a + (b - a) * t;
-}
-
-float getTowerHeight(int numDisks) {
-    float minHeight = 100.f;
-    float maxHeight = 480.f;
-    float factor = (maxHeight - minHeight) / 15;
-    return clamp(minHeight + numDisks * factor, minHeight, maxHeight);
-}
 
-void animateDiskMove(Disk &disk, const sf::Vector2f init, const sf::Vector2f goal, const float towerMax, const float delta) {
-    // the function will only use the delta to determine the position of the disk
-    // the delta is te range from 0-1 that describes the completion of the animation
-    float x, y;
-    if (delta < (3/8.f)) {
-        x = init.x;
-        y = linearInterpolation(init.y, towerMax, delta / (3/8.f));
-    } else if (delta < (5/8.f)) {
-        x = linearInterpolation(init.x, goal.x, (delta - 3/8.f) / (5/8.f - 3/8.f));
-        y = towerMax;
-    } else {
-        x = goal.x;
-        y = linearInterpolation(towerMax, goal.y, (delta - 5/8.f) / (1 - 5/8.f));
+    // Torres A, B, C, ...: el deque mantiene fijas las direcciones que guardan towers y labels
+    hanoi::Board board;
+    std::vector<Disk> disks;
+    DiskGeometry geometry;
+    std::deque<Tower> towerStorage;
+    std::deque<sf::Text> labelStorage;
+    std::vector<Tower*> towers;
+    std::vector<sf::Text*> labels;
+    for (int i = 0; i < numPegs; ++i) {
+        const char letter = 'A' + i;
+        towerStorage.emplace_back(board, disks, i, letter);
+        towers.push_back(&towerStorage.back());
+        labelStorage.emplace_back(std::string(1, letter), buttonFont, 14);
+        labelStorage.back().setFillColor(sf::Color::Black);
+        labels.push_back(&labelStorage.back());
     }
-    
-    disk.setPosition(x, y);
-};
-
-void restart(bool &iniciadoVisualizacion, int &indiceOperacion, Tower &a, Tower &b, Tower &c, int numDisks, const float windowWidth, const float diskHeight, std::vector<sf::Color> &colors, std::vector<Operation> &operations, RectButton &buttonPlus, RectButton &buttonMinus, RectButton &startButton, RectButton &restartButton) {
-    std::cout << "Reiniciando..." << std::endl;
-    iniciadoVisualizacion = false;
-    indiceOperacion = 0;
-    setDisks(a, b, c, numDisks, windowWidth, diskHeight, colors);
-    operations.clear();
-    buttonPlus.setButtonEnabled(true);
-    buttonMinus.setButtonEnabled(true);
-    restartButton.setButtonEnabled(false);
-    startButton.setButtonEnabled(true);
-};
-
-void calculateTowersPos(Tower &a, const float windowWidth, const float windowHeight, float towerHeight, Tower &b, Tower &c, sf::RectangleShape &base, sf::Text &labelA, sf::Text &labelB, sf::Text &labelC);
-
-int calcularNMovimientos(int numDiscos) {
-    return pow(2, numDiscos) - 1;
-}
-
-int main() {
-    const unsigned int FPS = 60;
-    int numDisks = 3;
-    int numMoves = calcularNMovimientos(numDisks);
-    const float windowWidth = 900;
-    const float windowHeight = 600;
-    float towerHeight = getTowerHeight(numDisks);
-    const float towerWidth = 20;
-    const float diskHeight = 30;
-    std::vector<Operation> operations;
-
-    sf::RenderWindow window(sf::VideoMode(windowWidth, windowHeight + 50), "Torre de Hanoi");
-    window.setFramerateLimit(FPS);
-
-    Tower a('A');
-    Tower b('B');
-    Tower c('C');
+    Tower& a = *towers.front();
+    Tower& goalTower = *towers.back();
 
     std::vector<sf::Color> colors = { sf::Color::Red, sf::Color::Green, sf::Color::Blue, sf::Color::Yellow, sf::Color::Magenta };
 
-    std::vector<Tower*> towers = { &a, &b, &c };
-
-    sf::Font buttonFont;
-    buttonFont.loadFromFile("./fonts/Arial.ttf");
+    Tower& startTower = editable ? a : *towers[savedLog.getFrom() % numPegs];
 
     // Gráficos
     sf::RectangleShape base;
-    base.setSize(sf::Vector2f(windowWidth - 100, towerWidth + 6));
+    base.setSize(sf::Vector2f(sceneWidth - 100, layout.towerWidth + 6));
     base.setFillColor(sf::Color::White);
-    sf::Text labelA("A", buttonFont, 14);
-    labelA.setFillColor(sf::Color::Black);
-    sf::Text labelB("B", buttonFont, 14);
-    labelB.setFillColor(sf::Color::Black);
-    sf::Text labelC("C", buttonFont, 14);
-    labelC.setFillColor(sf::Color::Black);
 
-    calculateTowersPos(a, windowWidth, windowHeight, towerHeight, b, c, base, labelA, labelB, labelC);
-    setDisks(a, b, c, numDisks, windowWidth, diskHeight, colors);
+    SceneRenderer sceneRenderer(buttonFont);
+    PerfHud perfHud(buttonFont);   // F3 lo muestra u oculta
+
+    calculateTowersPos(towers, sceneWidth, sceneHeight, layout.towerHeight, base, labels);
+    setDisks(board, disks, geometry, startTower, numDisks, layout, colors, numPegs);
+
+    // Recalcula las medidas para el numero de discos y el area actuales
+    auto relayout = [&]() {
+        layout = computeLayout(numDisks, numPegs, sceneWidth, sceneHeight);
+        base.setSize(sf::Vector2f(sceneWidth - 100, layout.towerWidth + 6));
+        calculateTowersPos(towers, sceneWidth, sceneHeight, layout.towerHeight, base, labels);
+    };
+    sf::View sceneView(sf::FloatRect(0, 0, windowWidth, windowHeight + 50));
+    sf::View controlsView = sceneView;
+    if (customStates) {
+        placeState(board, towers, startBoard);
+    }
 
     // Controles inicio
     sf::Text ndisksText("n: " + std::to_string(numDisks), buttonFont, 20);
@@ -261,6 +347,8 @@ int main() {
     startButton.setButtonLabel(20.f, "Iniciar visualizacion");
     startButton.setButtonColor(sf::Color(0, 200, 0), sf::Color(0, 150, 0), sf::Color(0, 100, 0));
     startButton.setLabelColor(sf::Color::White);
+    buttonPlus.setButtonEnabled(resizable);
+    buttonMinus.setButtonEnabled(resizable);
 
     // Controles visualizacion
     sf::Text currentOperationText("Operacion: --", buttonFont, 20);
@@ -272,9 +360,18 @@ int main() {
     restartButton.setLabelColor(sf::Color::White);
     restartButton.setButtonEnabled(false);
 
+    // Un solo despachador de eventos y un solo lote de dibujo para todos los botones
+    ButtonRouter buttonRouter;
+    ButtonBatch buttonBatch;
+    for (RectButton* button : { &buttonPlus, &buttonMinus, &startButton, &restartButton }) {
+        buttonRouter.add(*button);
+        buttonBatch.add(*button);
+    }
+
     // Estado
     bool iniciadoVisualizacion = false;
-    int indiceOperacion = 0;
+    std::uint64_t indiceOperacion = 0;
+    std::uint64_t finOperaciones = 0;
     bool animating = false;
     float delta = 0.f;
     sf::Vector2f goal;
@@ -282,159 +379,320 @@ int main() {
     Tower* currentSource = nullptr;
     Tower* currentDestination = nullptr;
     Disk* currentDisk = nullptr;
+    hanoi::Move currentOperation = {};
+    const std::uint64_t NingunaOperacion = ~std::uint64_t(0);
+    std::uint64_t operacionMostrada = NingunaOperacion;
+
+    // Velocidad en movimientos por segundo: flechas arriba/abajo la duplican o la reducen a la mitad
+    sf::Clock frameClock;
+
+    // La consola se escribe desde otro hilo: un terminal lento no frena los cuadros
+    hanoi::AsyncLogger consoleLog;
+    consoleLog.start(stdout);
+    sf::Text speedText("", buttonFont, 16);
+    speedText.setPosition(300, windowHeight + 5);
+    speedText.setFillColor(sf::Color::White);
+
+    // Los textos fijos solo se rearman cuando cambia lo que muestran
+    int discosMostrados = -1;
+    float velocidadMostrada = -1.f;
+
+    // Prepara la animacion de la operacion indiceOperacion; un registro
+    // cargado puede traer movimientos invalidos y detiene la reproduccion
+    auto startMove = [&]() {
+        hanoi::Move operation = sequence->at(indiceOperacion);
+        if (operation.source >= towers.size() || operation.destination >= towers.size() || !board.canMove(operation.source, operation.destination)) {
+            std::string errorStr = "Movimiento invalido en la operacion " + std::to_string(indiceOperacion + 1);
+            currentOperationText.setString(errorStr);
+            std::cerr << errorStr << std::endl;
+            finOperaciones = indiceOperacion;
+            animating = false;
+            return;
+        }
+
+        currentSource = towers[operation.source];
+        currentDestination = towers[operation.destination];
+        currentDisk = &currentSource->getTopDisk();
+        currentOperation = operation;
+
+        animating = true;
+        delta = 0.f;
+        const float goalX = currentDestination->getPosition().x - currentDisk->getSize().x / 2;
+        const float goalY = currentDestination->getPosition().y - (currentDestination->size() + 1) * layout.diskHeight - 10;
+        goal = sf::Vector2f(goalX, goalY);
+        init = sf::Vector2f(currentDisk->getPosition().x, currentDisk->getPosition().y);
+    };
+
+    auto startVisualization = [&]() {
+        if (customStates) {
+            sequence = &customSolution;
+        } else if (editable) {
+            if (hanoi::StaticSolution::covers(numDisks, numPegs)) {
+                staticSolution = hanoi::StaticSolution(numDisks, a.getPeg(), goalTower.getPeg());
+                sequence = &staticSolution;
+            } else if (numDisks <= MaxListDisks) {
+                solveHanoi(numDisks, towers, a, goalTower, operations);
+                sequence = &operations;
+            } else {
+                liveSolution.reset(new hanoi::FrameStewartGenerator(numDisks, numPegs, a.getPeg(), goalTower.getPeg()));
+                sequence = liveSolution.get();
+            }
+            if (!savePath.empty() && numDisks > MaxSavedDisks) {
+                std::cerr << "Con mas de " << MaxSavedDisks << " discos el registro seria demasiado grande; no se guarda" << std::endl;
+            } else if (!savePath.empty()) {
+                const bool saved = numPegs == 3
+                    ? hanoi::writeSolutionLog(savePath, numDisks, a.getPeg(), goalTower.getPeg())
+                    : hanoi::writeSolutionLog(savePath, hanoi::FrameStewartGenerator(numDisks, numPegs, a.getPeg(), goalTower.getPeg()));
+                if (!saved) {
+                    std::cerr << "No se pudo crear el registro " << savePath << std::endl;
+                }
+            }
+        }
+        finOperaciones = sequence->size();
+        iniciadoVisualizacion = true;
+        animating = false;
+        operacionMostrada = NingunaOperacion;
+        buttonPlus.setButtonEnabled(false);
+        buttonMinus.setButtonEnabled(false);
+        startButton.setButtonEnabled(false);
+    };
+
+    if (headless) {
+        startVisualization();
+    }
 
     sf::Event ev;
-    while (window.isOpen()) {
+    while (headless || window.isOpen()) {
+        perfHud.beginFrame();
+
         // Events
+        window.setView(controlsView);
         while (window.pollEvent(ev)) {
-            buttonPlus.getButtonStatus(window, ev);
-            buttonMinus.getButtonStatus(window, ev);
-            startButton.getButtonStatus(window, ev);
-            restartButton.getButtonStatus(window, ev);
+            buttonRouter.dispatch(window, ev);
             if (ev.type == sf::Event::Closed) {
                 window.close();
             }
 
+            // Al cambiar el tamano solo se reescalan las medidas de los discos;
+            // el movimiento en curso vuelve a empezar desde su torre
+            if (ev.type == sf::Event::Resized) {
+                const float width = ev.size.width;
+                const float height = ev.size.height;
+                sceneWidth = std::max(width, 300.f);
+                sceneHeight = std::max(height - 50, 200.f);
+                sceneView.reset(sf::FloatRect(0, 0, width, height));
+                controlsView.reset(sf::FloatRect(0, windowHeight + 50 - height, width, height));
+                window.setView(controlsView);
+                relayout();
+                applyLayout(geometry, towers, layout);
+                animating = false;
+                delta = 0.f;
+            }
+
             if (buttonPlus.isPressed) {
-                if (numDisks < 15) {
+                if (numDisks < (int)hanoi::MaxDisks) {
                     numDisks++;
-                    numMoves = calcularNMovimientos(numDisks);
-                    towerHeight = getTowerHeight(numDisks);
-                    calculateTowersPos(a, windowWidth, windowHeight, towerHeight, b, c, base, labelA, labelB, labelC);
-                    setDisks(a, b, c, numDisks, windowWidth, diskHeight, colors);
+                    numMoves = calcularNMovimientos(numDisks, numPegs);
+                    relayout();
+                    setDisks(board, disks, geometry, a, numDisks, layout, colors, numPegs);
                 }
             }
 
             if (buttonMinus.isPressed) {
                 if (numDisks > 1) {
                     numDisks--;
-                    numMoves = calcularNMovimientos(numDisks);
-                    towerHeight = getTowerHeight(numDisks);
-                    calculateTowersPos(a, windowWidth, windowHeight, towerHeight, b, c, base, labelA, labelB, labelC);
-                    setDisks(a, b, c, numDisks, windowWidth, diskHeight, colors);
+                    numMoves = calcularNMovimientos(numDisks, numPegs);
+                    relayout();
+                    setDisks(board, disks, geometry, a, numDisks, layout, colors, numPegs);
                 }
             }
 
             if (startButton.isPressed) {
-                solveHanoi(numDisks, a, b, c, operations);
-                setDisks(a, b, c, numDisks, windowWidth, diskHeight, colors);
-                iniciadoVisualizacion = true;
-                buttonPlus.setButtonEnabled(false);
-                buttonMinus.setButtonEnabled(false);
-                startButton.setButtonEnabled(false);
+                startVisualization();
+            }
+
+            if (ev.type == sf::Event::KeyPressed) {
+                if (ev.key.code == sf::Keyboard::F3) {
+                    perfHud.toggle();
+                } else if (ev.key.code == sf::Keyboard::Up && movesPerSecond < 8192.f) {
+                    movesPerSecond *= 2.f;
+                } else if (ev.key.code == sf::Keyboard::Down && movesPerSecond > 0.25f) {
+                    movesPerSecond /= 2.f;
+                }
+            }
+
+            // Saltos en la solucion: flechas de 10% en 10%, Inicio y Fin
+            if (ev.type == sf::Event::KeyPressed && iniciadoVisualizacion && editable) {
+                const std::uint64_t paso = finOperaciones / 10 > 0 ? finOperaciones / 10 : 1;
+                std::uint64_t destino = indiceOperacion;
+                if (ev.key.code == sf::Keyboard::Right) {
+                    destino = finOperaciones - indiceOperacion > paso ? indiceOperacion + paso : finOperaciones;
+                } else if (ev.key.code == sf::Keyboard::Left) {
+                    destino = indiceOperacion > paso ? indiceOperacion - paso : 0;
+                } else if (ev.key.code == sf::Keyboard::Home) {
+                    destino = 0;
+                } else if (ev.key.code == sf::Keyboard::End) {
+                    destino = finOperaciones;
+                }
+
+                if (destino != indiceOperacion) {
+                    if (customStates) {
+                        hanoi::Board state = startBoard;
+                        for (std::uint64_t i = 0; i < destino; ++i) {
+                            state.apply(customSolution.at(i));
+                        }
+                        placeState(board, towers, state);
+                    } else {
+                        seekOperation(board, towers, numDisks, a, goalTower, destino);
+                    }
+                    indiceOperacion = destino;
+                    animating = false;
+                    delta = 0.f;
+                    operacionMostrada = NingunaOperacion;
+                    currentOperationText.setString("[" + std::to_string(indiceOperacion) + "/" + std::to_string(finOperaciones) + "]");
+                    restartButton.setButtonEnabled(indiceOperacion >= finOperaciones);
+                }
             }
 
             if (restartButton.isPressed) {
-                restart(iniciadoVisualizacion, indiceOperacion, a, b, c, numDisks, windowWidth, diskHeight, colors, operations, buttonPlus, buttonMinus, startButton, restartButton);
+                consoleLog.logRestart();
+                restart(iniciadoVisualizacion, indiceOperacion, board, disks, geometry, startTower, numDisks, layout, colors, operations, resizable, buttonPlus, buttonMinus, startButton, restartButton);
+                if (customStates) {
+                    placeState(board, towers, startBoard);
+                }
             }
         }
 
+        perfHud.mark(PerfHud::EventsPhase);
+
         // Update
-        if (iniciadoVisualizacion && indiceOperacion < (int)operations.size()) {
-            // Animación
+        const std::uint64_t operacionAntes = indiceOperacion;
+        // El avance depende del tiempo real y no de los frames: delta cuenta
+        // movimientos completados del movimiento actual (0-1)
+        // Al exportar el paso es fijo y no depende de lo que tarde cada cuadro
+        float dt = headless ? 1.f / exportFps : frameClock.restart().asSeconds();
+        if (dt > 0.25f) {
+            dt = 0.25f;
+        }
+        if (iniciadoVisualizacion && indiceOperacion < finOperaciones) {
             if (!animating) {
-                Operation operation = operations[indiceOperacion];
-
-                std::string statusStr = "[" + std::to_string(indiceOperacion + 1) + "/" + std::to_string(operations.size()) + "]" + " Mover disco " + std::to_string(operation.diskNum) + " de " + std::string(1, operation.sourceLetter) + " a " + std::string(1, operation.destinationLetter);
-                currentOperationText.setString(statusStr);
-                std::cout << statusStr << std::endl;
-
-                Tower* source = nullptr;
-                Tower* destination = nullptr;
-                for (Tower* tower : towers) {
-                    if (tower->getLetter() == operation.sourceLetter) {
-                        source = tower;
-                    }
-                    if (tower->getLetter() == operation.destinationLetter) {
-                        destination = tower;
+                startMove();
+            }
+            if (animating) {
+                delta += dt * movesPerSecond;
+
+                // Turbo: los movimientos que terminarian dentro de este frame se
+                // aplican directamente y solo se anima el ultimo
+                while (animating && delta >= 1.f) {
+                    delta -= 1.f;
+                    animating = false;
+                    moveDisk(*currentSource, *currentDestination, operations, false);
+                    indiceOperacion++;
+                    if (indiceOperacion < finOperaciones) {
+                        const float resto = delta;
+                        startMove();
+                        delta = resto;
+                    } else {
+                        currentOperationText.setString("[" + std::to_string(indiceOperacion) + "/" + std::to_string(finOperaciones) + "]");
                     }
                 }
 
-                currentSource = source;
-                currentDestination = destination;
-                currentDisk = &source->getTopDisk();
+                if (animating) {
+                    animateDiskMove(*currentDisk, init, goal, a.getPosition().y - layout.towerHeight - 30, delta);
+                    // El texto solo se arma para el movimiento que se ve
+                    if (operacionMostrada != indiceOperacion) {
+                        operacionMostrada = indiceOperacion;
+                        char line[hanoi::MoveTextWriter::MaxLine];
+                        const std::size_t length = hanoi::formatMoveText(line, currentOperation, indiceOperacion, hanoi::MoveTextWriter::Verbose, numDisks, finOperaciones);
+                        std::string statusStr(line, length - 1);
+                        if (distances.isOpen() && (int)distances.getNumDisks() == numDisks) {
+                            statusStr += " (faltan " + std::to_string(distances.distance(board)) + ")";
+                        }
+                        currentOperationText.setString(statusStr);
+                        consoleLog.logMove(currentOperation, indiceOperacion, finOperaciones, numDisks);
+                    }
+                } else {
+                    delta = 0.f;
+                }
+            }
 
-                animating = true;
-                delta = 0.f;
-                const float goalX = destination->getPosition().x - currentDisk->getShape().getSize().x / 2;
-                const float goalY = destination->getPosition().y - (destination->getDisks().size() + 1) * diskHeight - 10;
-                goal = sf::Vector2f(goalX, goalY);
-                init = sf::Vector2f(currentDisk->getPosition().x, currentDisk->getPosition().y);
+            if (indiceOperacion >= finOperaciones) {
+                restartButton.setButtonEnabled(true);
             }
+        }
 
-            if (delta < 1.f) {
-                delta += 0.01f;
-                animateDiskMove(currentSource->getTopDisk(), init, goal, a.getPosition().y - towerHeight - 30, delta);
-            } else {
-                animating = false;
-                moveDisk(*currentSource, *currentDestination, operations, false);
-                indiceOperacion++;
+        perfHud.mark(PerfHud::UpdatePhase);
 
-                if (indiceOperacion >= (int)operations.size()) {
-                    restartButton.setButtonEnabled(true);
-                }
+        // Draw
+        target.clear();
+        unsigned int drawCalls = 0;
+
+        // - Base y torres, en dos llamadas de dibujo
+        target.setView(sceneView);
+        sceneRenderer.update(towers, geometry, base, labels, layout.towerWidth, layout.towerHeight);
+        target.draw(sceneRenderer);
+        drawCalls += sceneRenderer.getDrawCalls();
+        target.setView(controlsView);
+
+        // - Textos de estado
+        if (!iniciadoVisualizacion) {
+            if (discosMostrados != numDisks) {
+                discosMostrados = numDisks;
+                ndisksText.setString("n: " + std::to_string(numDisks) + ", movimientos necesarios: " + std::to_string(numMoves));
             }
+            target.draw(ndisksText);
+            drawCalls++;
         }
 
-        // Draw
-        window.clear();
-
-        // - Base
-        window.draw(base);
-        window.draw(labelA);
-        window.draw(labelB);
-        window.draw(labelC);
-
-        // - Torres
-        for (Tower* tower : towers) {
-            // Palo
-            sf::RectangleShape palo;
-            palo.setSize(sf::Vector2f(towerWidth, towerHeight));
-            palo.setFillColor(sf::Color::White);
-            palo.setPosition(tower->getPosition().x - towerWidth / 2, tower->getPosition().y - towerHeight);
-            window.draw(palo);
+        if (iniciadoVisualizacion) {
+            target.draw(currentOperationText);
+            drawCalls++;
         }
-        for (Tower* tower : towers) {
-            std::stack<Disk> disks = tower->getDisks();
-            // Discos
-            while (!disks.empty()) {
-                Disk disk = disks.top();
-                window.draw(disk.getShape());
-                sf::Text diskNum(std::to_string(disk.getNum()), buttonFont, 14);
-                diskNum.setPosition(
-                    disk.getShape().getPosition().x + disk.getShape().getSize().x / 2 - 7,
-                    disk.getShape().getPosition().y + disk.getShape().getSize().y / 2 - 7
-                );
-                diskNum.setFillColor(inverseLegibleColor(disk.getColor()));
-                window.draw(diskNum);
-                disks.pop();
-            }
+
+        // - Botones: los deshabilitados no se dibujan y el lote solo se
+        //   rehace cuando alguno cambia de estado
+        if (!headless) {
+            buttonBatch.update();
+            window.draw(buttonBatch);
+            drawCalls += buttonBatch.getDrawCalls();
         }
 
-        // - Botones
-        if (!iniciadoVisualizacion) {
-            ndisksText.setString("n: " + std::to_string(numDisks) + ", movimientos necesarios: " + std::to_string(numMoves));
-            window.draw(ndisksText);
-            buttonPlus.draw(window);
-            buttonMinus.draw(window);
-            startButton.draw(window);
+        if (velocidadMostrada != movesPerSecond) {
+            velocidadMostrada = movesPerSecond;
+            std::ostringstream speedStr;
+            speedStr << "Velocidad: " << movesPerSecond << " mov/s";
+            speedText.setString(speedStr.str());
         }
+        target.draw(speedText);
+        drawCalls++;
+
+        target.setView(sceneView);
+        perfHud.draw(target);
+        perfHud.mark(PerfHud::DrawPhase);
+
+        if (headless) {
+            exportTexture.display();
+            exporter.push(exportTexture.getTexture());
+        } else {
+            window.display();
+        }
+        perfHud.mark(PerfHud::DisplayPhase);
+        perfHud.endFrame(drawCalls, (unsigned int)(indiceOperacion - operacionAntes));
 
-        if (iniciadoVisualizacion) {
-            window.draw(currentOperationText);
-            restartButton.draw(window);
+        if (headless && indiceOperacion >= finOperaciones) {
+            break;
         }
+    }
 
-        window.display();
+    if (!perfCsvPath.empty() && !perfHud.dumpCsv(perfCsvPath)) {
+        std::cerr << "No se pudo escribir " << perfCsvPath << std::endl;
     }
-}
 
-void calculateTowersPos(Tower &a, const float windowWidth, const float windowHeight, float towerHeight, Tower &b, Tower &c, sf::RectangleShape &base, sf::Text &labelA, sf::Text &labelB, sf::Text &labelC) {
-    a.setPosition(1 * windowWidth / 4 - 15, windowHeight - (windowHeight - towerHeight) / 2);
-    b.setPosition(2 * windowWidth / 4, windowHeight - (windowHeight - towerHeight) / 2);
-    c.setPosition(3 * windowWidth / 4 + 15, windowHeight - (windowHeight - towerHeight) / 2);
-    base.setPosition(50, towerHeight + (windowHeight - towerHeight) / 2);
-    labelA.setPosition(a.getPosition().x - 5, a.getPosition().y + 4);
-    labelB.setPosition(b.getPosition().x - 5, b.getPosition().y + 4);
-    labelC.setPosition(c.getPosition().x - 5, c.getPosition().y + 4);
+    if (headless) {
+        if (!exporter.close()) {
+            std::cerr << "Error al escribir los cuadros en " << exportPath << std::endl;
+            return 1;
+        }
+        std::cout << exporter.getFrameCount() << " cuadros exportados en " << exportPath << std::endl;
+    }
 }